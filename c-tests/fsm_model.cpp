@@ -0,0 +1,685 @@
+/*
+ * fsm_model.cpp
+ *
+ * Latency / throughput calculator for tt_um_ashvin_viterbi, built on the
+ * cycle-accurate FSM model in fsm_model.h.
+ *
+ * Build:
+ *   g++ -O2 -std=c++17 -I../test -o fsm_model fsm_model.cpp
+ *
+ * Usage:
+ *   ./fsm_model [-k K] [-p ACS_PAR] [--pipe] [-r RADIX] [-f MAX_FRAME] [-n SYMS] [--clk MHZ]
+ *               [--byte-gap N] [--start-gap N] [--ack-delay N]
+ *               [--cut] [--out-mode N] [--nbuf 2] [--trunc] [--surv D] [--regx] [--pair] [--stream D]
+ *               [--block B] [--soft Q] [--punct P] [--tbite W] [--nctx N]
+ *               [--in-fifo D] [--out-fifo D] [--jitter J] [--sweep] [--verify]
+ *
+ *   default   one configuration: per-phase cycles, frame latency and
+ *             sustained decoded bits/s, from the cycle model
+ *   --sweep   table over K = 3..9 and frame lengths 8..MAX_FRAME; with -p,
+ *             ACS_PAR is clamped to NUM_STATES/2 per row
+ *   --verify  checks the closed form against the cycle model over a grid
+ *             of K, ACS_PAR, RADIX, frame length and host timing (exit 1 on
+ *             mismatch)
+ *
+ * -r 4 models the radix-4 datapath (ACS_PAR is then ignored). --pipe models
+ * ACS_PIPE = 1 (pipelined serial sweep, ACS_PAR = 0 only). --cut models
+ * CUT_THROUGH = 1 (ACS overlaps receive; decode is then START -> first byte
+ * out of what is left). --out-mode 1|2 models the one-byte-per-cycle and
+ * overlapped drains. --trunc closes the frame with TRUNC (no tail, all
+ * symbols' bits delivered). --surv D models SURV_DEPTH = D (survivor ring
+ * with window tracebacks), --regx REG_EXCHANGE = 1, --pair TB_PAIR = 1. --nbuf 2 adds
+ * the sustained rate of the ping-pong mode (NBUF = 2) with frames chained
+ * back to back through TopDriver::run_chain(). --stream D adds
+ * the continuous mode (CONTINUOUS = 1, TB_DEPTH = D) rate for comparison,
+ * with --block B bits per traceback pass (TB_BLOCK = B). --soft Q models
+ * SOFT = Q: one soft symbol per input byte, --punct P PUNCT = P (rate 2/3 or
+ * 3/4 punctured input, fewer bytes per frame). --tbite W models TAIL_BITE = W
+ * and closes the frame with TBITE (W warm-up passes, no tail). --nctx N adds
+ * the aggregate rate of NCTX = N channels sharing the decoder, each a link
+ * with the given host timing, through TopDriver::run_channels().
+ * --in-fifo D / --out-fifo D add the NBUF = 2 rate with IN_FIFO / OUT_FIFO
+ * = D pin FIFOs, next to the one without, for a host whose byte gaps and
+ * ack delays vary by --jitter J cycles either way (Timing::jitter, NBUF = 2
+ * lines only).
+ *
+ * Host timing matches topdrv::Timing: --byte-gap idle cycles after each
+ * input byte, --start-gap before START, --ack-delay cycles BYTE_OUT_VALID is
+ * held before READ_ACK. For a UART feeding the chip, byte_gap is about
+ * 10 * f_clk / baud - 1.
+ *
+ * The cycle counts are cross-checked against RTL by
+ * test/tb_top_verilator.cpp --check-model.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "fsm_model.h"
+#include "top_driver.h"
+
+using fsmmodel::Config;
+using fsmmodel::FrameCycles;
+using fsmmodel::FsmModel;
+
+static int frame_bits_for(int max_frame) {
+    int b = 6;  // project.v FRAME_BITS: at least 6, enough for MAX_FRAME
+    while ((1 << b) <= max_frame) ++b;
+    return b;
+}
+
+static Config make_config(int k, int max_frame, int acs_par = 0, int radix = 2, int nbuf = 1,
+                          bool cut = false, int out_mode = 0, int surv = 0,
+                          bool regx = false, bool pair = false, bool pipe = false,
+                          int soft = 0, int punct = 0, int tail_bite = 0, int nctx = 1,
+                          int in_fifo = 0, int out_fifo = 0) {
+    Config c;
+    c.best_search = true;   // BEST_SEARCH = 1, so --trunc delivers all bits
+    c.in_fifo = in_fifo;
+    c.out_fifo = out_fifo;
+    c.nctx = nctx;
+    c.tail_bite = tail_bite;
+    c.soft = soft;
+    c.punct = punct;
+    c.acs_pipe = pipe;
+    c.surv_depth = surv;
+    c.reg_exchange = regx;
+    c.tb_pair = pair;
+    c.out_mode = out_mode;
+    c.nbuf = nbuf;
+    c.cut_through = cut;
+    c.k = k;
+    c.max_frame = max_frame;
+    c.acs_par = radix == 4 ? 0 : acs_par;
+    c.radix = radix;
+    c.frame_bits = frame_bits_for(max_frame);
+    return c;
+}
+
+// Run frames back to back through the cycle model and return the cycles
+// of the last one (the first frame after reset has the same schedule).
+static topdrv::FrameResult run_model(const Config &cfg, int num_syms,
+                                     const topdrv::Timing &tm, int frames = 2,
+                                     bool trunc = false, bool tbite = false) {
+    FsmModel m(cfg);
+    topdrv::TopDriver<FsmModel> drv(&m, 1u << 24);
+    drv.set_trunc(trunc);
+    drv.set_tbite(tbite);
+    drv.set_soft(cfg.soft);
+    drv.set_punct(cfg.punct);
+    drv.reset();
+    static uint8_t syms[4096];
+    topdrv::FrameResult r;
+    for (int i = 0; i < frames; ++i) r = drv.run_frame(syms, num_syms, tm);
+    return r;
+}
+
+// Steady-state cycles per frame with NBUF = 2: the difference between
+// chaining 2N and N frames, so pipeline fill and final drain cancel out.
+static double chain_cycles_per_frame(const Config &cfg, int num_syms, const topdrv::Timing &tm,
+                                     bool trunc, bool tbite, bool *ok) {
+    static uint8_t syms[4096];
+    const int n = 8;
+    uint64_t cyc[2];
+    *ok = true;
+    for (int i = 0; i < 2; ++i) {
+        FsmModel m(cfg);
+        topdrv::TopDriver<FsmModel> drv(&m, 1u << 24);
+        drv.set_trunc(trunc);
+        drv.set_tbite(tbite);
+        drv.set_soft(cfg.soft);
+        drv.set_punct(cfg.punct);
+        drv.reset();
+        topdrv::FrameResult r = drv.run_chain(syms, num_syms, n << i, tm);
+        *ok = *ok && r.ok;
+        cyc[i] = r.cycles;
+    }
+    return (double)(cyc[1] - cyc[0]) / n;
+}
+
+// Steady-state cycles per frame, all channels together, with NCTX channels
+// fed by run_channels(): as above, 2N against N frames per channel.
+static double channel_cycles_per_frame(const Config &cfg, int num_syms, const topdrv::Timing &tm,
+                                       bool trunc, bool tbite, bool *ok) {
+    static uint8_t syms[4096];
+    const int n = 8;
+    uint64_t cyc[2];
+    *ok = true;
+    for (int i = 0; i < 2; ++i) {
+        FsmModel m(cfg);
+        topdrv::TopDriver<FsmModel> drv(&m, 1u << 24);
+        drv.set_trunc(trunc);
+        drv.set_tbite(tbite);
+        drv.set_soft(cfg.soft);
+        drv.set_punct(cfg.punct);
+        drv.reset();
+        topdrv::FrameResult r = drv.run_channels(syms, num_syms, n << i, cfg.nctx, tm);
+        *ok = *ok && r.ok;
+        cyc[i] = r.cycles;
+    }
+    return (double)(cyc[1] - cyc[0]) / (n * cfg.nctx);
+}
+
+static void report(const Config &cfg, int num_syms, const topdrv::Timing &tm, double mhz,
+                   bool trunc, bool tbite, int stream_depth, int stream_block) {
+    // One frame through the single-buffer FSM; NBUF = 2 and NCTX are
+    // reported below
+    Config single = cfg;
+    single.nbuf = 1;
+    single.nctx = 1;
+    topdrv::FrameResult r = run_model(single, num_syms, tm, 2, trunc, tbite);
+    FrameCycles c = fsmmodel::frame_cycles(single, (unsigned)num_syms, tm.byte_gap,
+                                           tm.start_gap, tm.ack_delay, trunc, tbite);
+    if (!r.ok) {
+        printf("model timed out\n");
+        return;
+    }
+    const double ns = 1e3 / mhz;
+    printf("K=%d ACS_PAR=%d%s RADIX=%d%s OUT_MODE=%d MAX_FRAME=%d SURV_DEPTH=%d%s SOFT=%d PUNCT=%d TAIL_BITE=%d symbols=%d%s%s clk=%.1f MHz byte_gap=%u start_gap=%u ack_delay=%u\n",
+           cfg.k, cfg.acs_par, fsmmodel::acs_pipe(cfg) ? " ACS_PIPE" : "", cfg.radix, cfg.cut_through ? " CUT_THROUGH" : "", cfg.out_mode, cfg.max_frame,
+           cfg.surv_depth, cfg.reg_exchange ? " REG_EXCHANGE" : "", cfg.soft, cfg.punct, cfg.tail_bite, num_syms, trunc ? " TRUNC" : "", tbite ? " TBITE" : "", mhz, tm.byte_gap, tm.start_gap, tm.ack_delay);
+    printf("  ACS      %8u cycles per %u symbol%s%s\n", fsmmodel::acs_step_cycles(cfg),
+           fsmmodel::syms_per_step(cfg), cfg.radix == 4 ? "s" : "",
+           fsmmodel::acs_full(cfg) ? "  (fully parallel)" : "");
+    printf("  receive  %8llu cycles\n", (unsigned long long)c.receive);
+    printf("  decode   %8llu cycles  (START -> first output byte)\n",
+           (unsigned long long)r.decode_cycles);
+    printf("  drain    %8llu cycles\n", (unsigned long long)(r.cycles - c.receive - r.decode_cycles));
+    printf("  frame    %8llu cycles  %.2f us\n", (unsigned long long)r.cycles, r.cycles * ns / 1e3);
+    printf("  output   %8u bits/frame\n", c.out_bits);
+    printf("  cycles/bit %.2f   throughput %.3f Mbit/s decoded, %.3f Mbit/s coded in\n",
+           (double)r.cycles / c.out_bits, mhz * c.out_bits / (double)r.cycles,
+           mhz * num_syms * punct_units(cfg.punct) / punct_period(cfg.punct) / (double)r.cycles);
+    if (cfg.nbuf == 2) {
+        bool ok;
+        Config pp = cfg;
+        pp.nctx = 1;
+        pp.in_fifo = pp.out_fifo = 0;
+        const double cpf = chain_cycles_per_frame(pp, num_syms, tm, trunc, tbite, &ok);
+        if (!ok)
+            printf("  ping-pong NBUF=2: model timed out\n");
+        else
+            printf("  ping-pong NBUF=2: %.1f cycles/frame sustained   cycles/bit %.2f   "
+                   "throughput %.3f Mbit/s decoded\n", cpf, cpf / c.out_bits, mhz * c.out_bits / cpf);
+        if (cfg.in_fifo || cfg.out_fifo) {
+            pp.in_fifo = cfg.in_fifo;
+            pp.out_fifo = cfg.out_fifo;
+            const double fpf = chain_cycles_per_frame(pp, num_syms, tm, trunc, tbite, &ok);
+            if (!ok)
+                printf("  IN_FIFO=%d OUT_FIFO=%d: model timed out\n", cfg.in_fifo, cfg.out_fifo);
+            else
+                printf("  IN_FIFO=%d OUT_FIFO=%d: %.1f cycles/frame sustained   cycles/bit %.2f   "
+                       "throughput %.3f Mbit/s decoded\n", cfg.in_fifo, cfg.out_fifo, fpf,
+                       fpf / c.out_bits, mhz * c.out_bits / fpf);
+        }
+    }
+    if (cfg.nctx > 1) {
+        bool ok;
+        const double cpf = channel_cycles_per_frame(cfg, num_syms, tm, trunc, tbite, &ok);
+        if (!ok)
+            printf("  NCTX=%d: model timed out\n", cfg.nctx);
+        else
+            printf("  NCTX=%d: %.1f cycles/frame sustained over all channels   cycles/bit %.2f   "
+                   "throughput %.3f Mbit/s decoded, %.3f per channel\n", cfg.nctx, cpf,
+                   cpf / c.out_bits, mhz * c.out_bits / cpf, mhz * c.out_bits / cpf / cfg.nctx);
+    }
+    if (stream_depth > 0) {
+        const double cps =
+            fsmmodel::stream_cycles_per_symbol(cfg, (unsigned)stream_depth, (unsigned)stream_block);
+        printf("  continuous TB_DEPTH=%d TB_BLOCK=%d: %.2f cycles/bit   throughput %.3f Mbit/s "
+               "decoded, latency %d symbols\n", stream_depth, stream_block, cps, mhz / cps,
+               stream_depth - 1 + stream_block - 1 + cfg.k - 1);
+    }
+}
+
+static void sweep(int max_frame, int acs_par, int radix, const topdrv::Timing &tm, double mhz) {
+    printf("# decoded Mbit/s at %.1f MHz, ACS_PAR=%d RADIX=%d (byte_gap=%u start_gap=%u ack_delay=%u)\n",
+           mhz, acs_par, radix, tm.byte_gap, tm.start_gap, tm.ack_delay);
+    printf("%-4s", "K");
+    for (int L = 8; L <= max_frame; L *= 2) {
+        char hdr[16];
+        snprintf(hdr, sizeof(hdr), "L=%d", L);
+        printf(" %14s", hdr);
+    }
+    printf("\n");
+    for (int k = 3; k <= 9; ++k) {
+        const int half = 1 << (k - 2);
+        Config cfg = make_config(k, max_frame, acs_par > half ? half : acs_par, radix);
+        printf("%-4d", k);
+        for (int L = 8; L <= max_frame; L *= 2) {
+            if (L <= k - 1) { printf(" %14s", "-"); continue; }
+            FrameCycles c = fsmmodel::frame_cycles(cfg, (unsigned)L, tm.byte_gap,
+                                                   tm.start_gap, tm.ack_delay);
+            printf(" %14.3f", mhz * c.out_bits / (double)c.total);
+        }
+        printf("\n");
+    }
+}
+
+static int verify(void) {
+    int checked = 0, bad = 0;
+    const unsigned gaps[] = {0, 1, 3, 17};
+    for (int k = 3; k <= 9; ++k) {
+      // p = -1: radix-4, -2: ACS_PAR = 0 with ACS_PIPE
+      for (int p = -2; p <= (1 << (k - 2)); p = p > 0 ? 2 * p : p + 1) {
+        for (int mf : {32, 64, 31}) {
+          for (int om : {0, 1}) {
+           for (int sd : {0, 8, 16, -1, -2}) {
+            for (int q : {0, 3}) {
+            for (int pu : {0, 1, 2}) {
+            // sd = -1: REG_EXCHANGE, -2: TB_PAIR; MAX_FRAME = 31 gives odd frames.
+            // SOFT and PUNCT only change the receive side: one OUT_MODE, two
+            // frame sizes. Frames are closed plain, with TRUNC or with TBITE,
+            // TAIL_BITE = 1..3 by K
+            if (mf == 31 && sd != -2) continue;
+            if ((q || pu) && (om || mf == 64)) continue;
+            Config cfg = make_config(k, mf, p < 0 ? 0 : p, p == -1 ? 4 : 2, 1, false, om,
+                                     sd < 0 ? 0 : sd, sd == -1, sd == -2, p == -2, q, pu,
+                                     1 + k % 3);
+            for (int n = k; n <= mf; ++n) {
+              for (int fl : {0, 1, 2}) {
+                const bool tr = fl == 1, tb = fl == 2;
+                const int L = (int)fsmmodel::frame_syms(cfg, fsmmodel::frame_bytes(cfg, (unsigned)n));
+                if (tb && !fsmmodel::tail_bite(cfg)) continue;
+                if (!fl && (L > mf ? mf : L) <= k - 1) continue;
+                for (unsigned g : gaps) {
+                    topdrv::Timing tm;
+                    tm.byte_gap = g;
+                    tm.start_gap = g / 2;
+                    tm.ack_delay = g;
+                    topdrv::FrameResult r = run_model(cfg, n, tm, 2, tr, tb);
+                    FrameCycles c = fsmmodel::frame_cycles(cfg, (unsigned)n, tm.byte_gap,
+                                                           tm.start_gap, tm.ack_delay, tr, tb);
+                    ++checked;
+                    if (!r.ok || r.cycles != c.total ||
+                        r.decode_cycles != c.decode || r.bits.size() / 8 != (c.out_bits + 7) / 8) {
+                        ++bad;
+                        printf("MISMATCH K=%d P=%d MAX_FRAME=%d OUT_MODE=%d SURV_DEPTH=%d SOFT=%d PUNCT=%d n=%d trunc=%d tbite=%d gap=%u model=%llu/%llu closed=%llu/%llu\n",
+                               k, p, mf, om, sd, q, pu, n, tr, tb, g, (unsigned long long)r.cycles,
+                               (unsigned long long)r.decode_cycles,
+                               (unsigned long long)c.total, (unsigned long long)c.decode);
+                    }
+                }
+              }
+            }
+            }
+            }
+           }
+          }
+        }
+      }
+    }
+    // CUT_THROUGH and OUT_MODE 2 have no closed form: the model must finish
+    // every frame with the same output and never be slower than the
+    // schedule they improve on, tail-biting frames included. Radix-4 also
+    // runs SOFT = 3, where odd frames end with a half step
+    for (int k = 3; k <= 7; ++k) {
+      for (int p = -2; p <= (1 << (k - 2)); p = p > 0 ? 2 * p : p + 1) {
+        for (int n = k; n <= 32; ++n) {
+          for (int sd : {0, 8, -1, -2}) {
+            for (unsigned g : {0u, 5u, 40u, 400u}) {
+              for (bool tb : {false, true}) {
+               for (int q = 0; q <= (p == -1 ? 3 : 0); q += 3) {
+                topdrv::Timing tm;
+                tm.byte_gap = g;
+                tm.ack_delay = g % 7;
+                Config cfg = make_config(k, 32, p < 0 ? 0 : p, p == -1 ? 4 : 2, 1, false, 0,
+                                         sd < 0 ? 0 : sd, sd == -1, sd == -2, p == -2, q, 0, 2);
+                if (tb && !fsmmodel::tail_bite(cfg)) continue;
+                topdrv::FrameResult base = run_model(cfg, n, tm, 2, false, tb);
+                cfg.cut_through = true;
+                topdrv::FrameResult r = run_model(cfg, n, tm, 2, false, tb);
+                ++checked;
+                if (!r.ok || r.bits.size() != base.bits.size() ||
+                    r.decode_cycles > base.decode_cycles || r.cycles > base.cycles) {
+                    ++bad;
+                    printf("MISMATCH cut-through K=%d P=%d SOFT=%d SURV_DEPTH=%d n=%d tbite=%d gap=%u decode=%llu/%llu\n", k, p, q, sd, n, tb, g,
+                           (unsigned long long)r.decode_cycles, (unsigned long long)base.decode_cycles);
+                }
+                cfg.cut_through = false;
+                cfg.out_mode = 1;
+                base = run_model(cfg, n, tm, 2, false, tb);
+                cfg.out_mode = 2;
+                r = run_model(cfg, n, tm, 2, false, tb);
+                ++checked;
+                if (!r.ok || r.bits.size() != base.bits.size() || r.cycles > base.cycles) {
+                    ++bad;
+                    printf("MISMATCH OUT_MODE=2 K=%d P=%d SOFT=%d SURV_DEPTH=%d n=%d tbite=%d gap=%u cycles=%llu/%llu\n",
+                           k, p, q, sd, n, tb, g, (unsigned long long)r.cycles, (unsigned long long)base.cycles);
+                }
+               }
+              }
+            }
+          }
+        }
+      }
+    }
+    // NCTX has no closed form: every channel must deliver all its frames.
+    // On slow links, where sharing the decoder pays, N channels must also
+    // never be slower than one NBUF = 2 link carrying the same frames one
+    // after another (a host that keeps one link busy fills no faster with
+    // several)
+    static uint8_t zeros[64];
+    for (int k = 3; k <= 7; ++k) {
+      for (int p = -2; p <= (1 << (k - 2)); p = p > 0 ? 2 * p : p + 1) {
+        for (int nc : {2, 3, 8}) {
+          for (int n : {k + 1, 19, 32}) {
+            for (unsigned g : {0u, 7u, 150u}) {
+              for (int fl : {0, 1, 2}) {
+                const bool tr = fl == 1, tb = fl == 2;
+                topdrv::Timing tm;
+                tm.byte_gap = g;
+                tm.start_gap = g / 3;
+                tm.ack_delay = g % 5;
+                Config cfg = make_config(k, 32, p < 0 ? 0 : p, p == -1 ? 4 : 2, 2, false, 0, 0,
+                                         false, false, p == -2, fl ? 0 : 3, 0, 1, nc);
+                if (tb && !fsmmodel::tail_bite(cfg)) continue;
+                const int frames = 3;
+                FsmModel mc(cfg);
+                topdrv::TopDriver<FsmModel> dmc(&mc, 1u << 22);
+                dmc.set_trunc(tr);
+                dmc.set_tbite(tb);
+                dmc.set_soft(cfg.soft);
+                dmc.reset();
+                topdrv::FrameResult r = dmc.run_channels(zeros, n, frames, nc, tm);
+                cfg.nctx = 1;
+                FsmModel pp(cfg);
+                topdrv::TopDriver<FsmModel> dpp(&pp, 1u << 22);
+                dpp.set_trunc(tr);
+                dpp.set_tbite(tb);
+                dpp.set_soft(cfg.soft);
+                dpp.reset();
+                topdrv::FrameResult base = dpp.run_chain(zeros, n, frames * nc, tm);
+                ++checked;
+                if (!r.ok || !base.ok || r.bits.size() != base.bits.size() ||
+                    (g >= 150 && r.cycles > base.cycles)) {
+                    ++bad;
+                    printf("MISMATCH NCTX=%d K=%d P=%d n=%d trunc=%d tbite=%d gap=%u bits=%zu/%zu cycles=%llu/%llu\n",
+                           nc, k, p, n, tr, tb, g, r.bits.size(), base.bits.size(),
+                           (unsigned long long)r.cycles, (unsigned long long)base.cycles);
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+    // IN_FIFO / OUT_FIFO have no closed form either: the same frames must
+    // come out as without them. With steady host timing they must never be
+    // slower, but for the cycle the FIFO adds to the end of the run. With
+    // jitter a greedy host can lose a few cycles on one run when its reads
+    // and writes land differently, so there only the total over the grid
+    // must stay within the same cycle per run. With the output FIFO a host
+    // that sends input first must get the same frames, and the FIFO must
+    // have handed it the pins while output bytes were queued
+    uint64_t jit_cycles[4] = {0, 0, 0, 0}, jit_runs = 0, granted = 0;
+    for (int k = 3; k <= 7; k += 2) {
+      for (int p = -2; p <= (1 << (k - 2)); p = p > 0 ? 2 * p : p + 1) {
+        for (int n : {k + 1, 19, 32}) {
+          for (unsigned g : {0u, 12u, 40u, 90u}) {
+            for (unsigned j : {0u, 30u, 90u}) {
+              for (int fi : {1, 2, 3}) {
+                topdrv::Timing tm;
+                tm.byte_gap = g;
+                tm.start_gap = g / 4;
+                tm.ack_delay = g % 3 * 10;
+                tm.jitter = j;
+                Config cfg = make_config(k, 32, p < 0 ? 0 : p, p == -1 ? 4 : 2, 2, false, 0, 0,
+                                         false, false, p == -2, (n == 19) ? 3 : 0, 0, 0, 1);
+                const int frames = 16;
+                FsmModel pp(cfg);
+                topdrv::TopDriver<FsmModel> dpp(&pp, 1u << 22);
+                dpp.set_soft(cfg.soft);
+                dpp.reset();
+                topdrv::FrameResult base = dpp.run_chain(zeros, n, frames, tm);
+                cfg.in_fifo = (fi & 1) ? 16 : 0;
+                cfg.out_fifo = (fi & 2) ? 8 : 0;
+                FsmModel mf(cfg);
+                topdrv::TopDriver<FsmModel> dmf(&mf, 1u << 22);
+                dmf.set_soft(cfg.soft);
+                dmf.reset();
+                topdrv::FrameResult r = dmf.run_chain(zeros, n, frames, tm);
+                ++checked;
+                if (j) {
+                    jit_cycles[0] += base.cycles;
+                    jit_cycles[fi] += r.cycles;
+                    jit_runs += fi == 1;
+                }
+                if (!r.ok || !base.ok || r.bits.size() != base.bits.size() ||
+                    (!j && r.cycles > base.cycles + 1)) {
+                    ++bad;
+                    printf("MISMATCH IN_FIFO=%d OUT_FIFO=%d K=%d P=%d n=%d gap=%u jitter=%u bits=%zu/%zu cycles=%llu/%llu\n",
+                           cfg.in_fifo, cfg.out_fifo, k, p, n, g, j, r.bits.size(),
+                           base.bits.size(), (unsigned long long)r.cycles,
+                           (unsigned long long)base.cycles);
+                }
+                if (fi & 2) {
+                    FsmModel mi(cfg);
+                    topdrv::TopDriver<FsmModel> dmi(&mi, 1u << 22);
+                    dmi.set_soft(cfg.soft);
+                    dmi.set_input_first(true);
+                    dmi.reset();
+                    topdrv::FrameResult ri = dmi.run_chain(zeros, n, frames, tm);
+                    granted += dmi.granted();
+                    ++checked;
+                    if (!ri.ok || ri.bits != base.bits) {
+                        ++bad;
+                        printf("MISMATCH input first IN_FIFO=%d OUT_FIFO=%d K=%d P=%d n=%d gap=%u jitter=%u bits=%zu/%zu\n",
+                               cfg.in_fifo, cfg.out_fifo, k, p, n, g, j, ri.bits.size(),
+                               base.bits.size());
+                    }
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+    // NBUF = 2 slots that do not end on a byte boundary: a frame that fills
+    // the slot exactly ends in a byte whose padding completes symbols past
+    // MAX_FRAME (up to 6 with PUNCT = 1). The slot must keep MAX_FRAME
+    // symbols, so every frame delivers the bits of exactly MAX_FRAME
+    for (int k = 3; k <= 7; k += 2) {
+      for (int mf : {29, 30, 31, 32}) {
+        for (int q : {0, 3}) {
+          for (int pu : {0, 1, 2}) {
+            Config cfg = make_config(k, mf, 0, 2, 2, false, 0, 0, false, false, false, q, pu, 0, 1);
+            const int frames = 4;
+            FsmModel pp(cfg);
+            topdrv::TopDriver<FsmModel> dpp(&pp, 1u << 22);
+            dpp.set_soft(q);
+            dpp.set_punct(pu);
+            dpp.reset();
+            topdrv::FrameResult r = dpp.run_chain(zeros, mf, frames, topdrv::Timing());
+            const size_t want = (size_t)frames * (size_t)((mf - (k - 1) + 7) / 8) * 8;
+            ++checked;
+            if (!r.ok || r.bits.size() != want) {
+                ++bad;
+                printf("MISMATCH full slot K=%d MAX_FRAME=%d SOFT=%d PUNCT=%d bits=%zu/%zu\n",
+                       k, mf, q, pu, r.bits.size(), want);
+            }
+          }
+        }
+      }
+    }
+    // Frames no longer than the tail (one hard byte at K >= 5, a few soft
+    // ones) carry no data bits: the frame must end with no output byte
+    // instead of draining stale out_buf bytes
+    for (int k = 3; k <= 9; ++k) {
+      for (int q : {0, 3}) {
+        for (int nb : {1, 2}) {
+          for (int om : {0, 1, 2}) {
+            if (nb == 2 && om) continue;
+            Config cfg = make_config(k, 32, 0, 2, nb, false, om, 0, false, false, false, q);
+            for (int n = 1; n <= k - 1; ++n) {
+              if ((int)fsmmodel::frame_syms(cfg, fsmmodel::frame_bytes(cfg, (unsigned)n)) > k - 1)
+                continue;
+              topdrv::FrameResult r;
+              if (nb == 2) {
+                FsmModel pp(cfg);
+                topdrv::TopDriver<FsmModel> dpp(&pp, 1u << 22);
+                dpp.set_soft(q);
+                dpp.reset();
+                r = dpp.run_chain(zeros, n, 3, topdrv::Timing());
+              } else {
+                r = run_model(cfg, n, topdrv::Timing());
+              }
+              ++checked;
+              if (!r.ok || !r.bits.empty()) {
+                ++bad;
+                printf("MISMATCH tail-only frame K=%d SOFT=%d NBUF=%d OUT_MODE=%d n=%d ok=%d bits=%zu\n",
+                       k, q, nb, om, n, r.ok, r.bits.size());
+              }
+            }
+          }
+        }
+      }
+    }
+    for (int fi : {1, 2, 3}) {
+        ++checked;
+        if (jit_cycles[fi] > jit_cycles[0] / 3 + jit_runs) {
+            ++bad;
+            printf("MISMATCH IN_FIFO=%d OUT_FIFO=%d with jitter: %llu cycles against %llu\n",
+                   (fi & 1) ? 16 : 0, (fi & 2) ? 8 : 0, (unsigned long long)jit_cycles[fi],
+                   (unsigned long long)(jit_cycles[0] / 3));
+        } else {
+            printf("verify: IN_FIFO=%d OUT_FIFO=%d with jitter: %llu cycles, %llu without\n",
+                   (fi & 1) ? 16 : 0, (fi & 2) ? 8 : 0, (unsigned long long)jit_cycles[fi],
+                   (unsigned long long)(jit_cycles[0] / 3));
+        }
+    }
+    ++checked;
+    if (!granted) {
+        ++bad;
+        printf("MISMATCH OUT_FIFO never released uio to an input-first host\n");
+    } else {
+        printf("verify: OUT_FIFO input-first hosts: %llu bytes sent past queued output\n",
+               (unsigned long long)granted);
+    }
+    printf("verify: %d configurations, %d mismatches\n", checked, bad);
+    return bad ? 1 : 0;
+}
+
+int main(int argc, char **argv) {
+    int k = 5, acs_par = 0, radix = 2, max_frame = 32, num_syms = -1, stream_depth = 0;
+    int stream_block = 1;
+    int surv = 0;
+    bool regx = false, pair = false, pipe = false;
+    int soft = 0, punct = 0, tail_bite = 0;
+    int nbuf = 1, nctx = 1, in_fifo = 0, out_fifo = 0;
+    bool cut = false, trunc = false;
+    int out_mode = 0;
+    double mhz = 50.0;
+    bool do_sweep = false, do_verify = false;
+    topdrv::Timing tm;
+
+    for (int i = 1; i < argc; ++i) {
+        const char *a = argv[i];
+        const bool has_val = i + 1 < argc;
+        if (!strcmp(a, "-k") && has_val) k = atoi(argv[++i]);
+        else if (!strcmp(a, "-p") && has_val) acs_par = atoi(argv[++i]);
+        else if (!strcmp(a, "--pipe")) pipe = true;
+        else if (!strcmp(a, "-r") && has_val) radix = atoi(argv[++i]);
+        else if (!strcmp(a, "-f") && has_val) max_frame = atoi(argv[++i]);
+        else if (!strcmp(a, "-n") && has_val) num_syms = atoi(argv[++i]);
+        else if (!strcmp(a, "--clk") && has_val) mhz = atof(argv[++i]);
+        else if (!strcmp(a, "--byte-gap") && has_val) tm.byte_gap = (unsigned)atoi(argv[++i]);
+        else if (!strcmp(a, "--start-gap") && has_val) tm.start_gap = (unsigned)atoi(argv[++i]);
+        else if (!strcmp(a, "--ack-delay") && has_val) tm.ack_delay = (unsigned)atoi(argv[++i]);
+        else if (!strcmp(a, "--cut")) cut = true;
+        else if (!strcmp(a, "--out-mode") && has_val) out_mode = atoi(argv[++i]);
+        else if (!strcmp(a, "--nbuf") && has_val) nbuf = atoi(argv[++i]);
+        else if (!strcmp(a, "--trunc")) trunc = true;
+        else if (!strcmp(a, "--surv") && has_val) surv = atoi(argv[++i]);
+        else if (!strcmp(a, "--regx")) regx = true;
+        else if (!strcmp(a, "--pair")) pair = true;
+        else if (!strcmp(a, "--stream") && has_val) stream_depth = atoi(argv[++i]);
+        else if (!strcmp(a, "--block") && has_val) stream_block = atoi(argv[++i]);
+        else if (!strcmp(a, "--soft") && has_val) soft = atoi(argv[++i]);
+        else if (!strcmp(a, "--punct") && has_val) punct = atoi(argv[++i]);
+        else if (!strcmp(a, "--tbite") && has_val) tail_bite = atoi(argv[++i]);
+        else if (!strcmp(a, "--nctx") && has_val) nctx = atoi(argv[++i]);
+        else if (!strcmp(a, "--in-fifo") && has_val) in_fifo = atoi(argv[++i]);
+        else if (!strcmp(a, "--out-fifo") && has_val) out_fifo = atoi(argv[++i]);
+        else if (!strcmp(a, "--jitter") && has_val) tm.jitter = (unsigned)atoi(argv[++i]);
+        else if (!strcmp(a, "--sweep")) do_sweep = true;
+        else if (!strcmp(a, "--verify")) do_verify = true;
+        else {
+            fprintf(stderr, "usage: %s [-k K] [-p ACS_PAR] [--pipe] [-r RADIX] [-f MAX_FRAME] [-n SYMS] [--clk MHZ] "
+                            "[--byte-gap N] [--start-gap N] [--ack-delay N] [--cut] [--out-mode N] [--nbuf 2] [--trunc] [--surv D] [--regx] [--pair] [--stream D] [--block B] [--soft Q] [--punct P] [--tbite W] [--nctx N] [--in-fifo D] [--out-fifo D] [--jitter J] [--sweep] [--verify]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+
+    if (do_verify) return verify();
+
+    if (k < 2 || k > 16 || max_frame < 4 || max_frame > 4000) {
+        fprintf(stderr, "K must be 2..16 and MAX_FRAME 4..4000\n");
+        return 2;
+    }
+    if (radix != 2 && radix != 4) {
+        fprintf(stderr, "RADIX must be 2 or 4\n");
+        return 2;
+    }
+    if (do_sweep) {
+        sweep(max_frame, acs_par, radix, tm, mhz);
+        return 0;
+    }
+    if (num_syms < 0) num_syms = max_frame;
+    if (num_syms > max_frame) num_syms = max_frame;
+    if (soft < 0 || soft > 4) {
+        fprintf(stderr, "SOFT must be 0 (hard decision) or 1..4 sample bits\n");
+        return 2;
+    }
+    if (punct < 0 || punct > 2) {
+        fprintf(stderr, "PUNCT must be 0 (rate 1/2), 1 (2/3) or 2 (3/4)\n");
+        return 2;
+    }
+    if (tail_bite < 0 || tail_bite > 3) {
+        fprintf(stderr, "TAIL_BITE must be 0 (off) or 1..3 warm-up passes\n");
+        return 2;
+    }
+    const Config shape = make_config(k, max_frame, 0, 2, 1, false, 0, 0, false, false, false,
+                                     soft, punct);
+    if (!trunc && !tail_bite && fsmmodel::frame_syms(shape, fsmmodel::frame_bytes(shape, (unsigned)num_syms)) <=
+                      (unsigned)(k - 1)) {
+        fprintf(stderr, "frame of %d symbols carries no data bits at K=%d\n", num_syms, k);
+        return 2;
+    }
+    if (acs_par < 0 || acs_par > (1 << (k - 2)) || (acs_par & (acs_par - 1))) {
+        fprintf(stderr, "ACS_PAR must be 0 or a power of two up to NUM_STATES/2 = %d\n", 1 << (k - 2));
+        return 2;
+    }
+    if (nbuf != 1 && nbuf != 2) {
+        fprintf(stderr, "NBUF must be 1 or 2\n");
+        return 2;
+    }
+    if (nctx < 1 || nctx > 8) {
+        fprintf(stderr, "NCTX must be 1..8\n");
+        return 2;
+    }
+    for (int d : {in_fifo, out_fifo}) {
+        if (d < 0 || d == 1 || d > 64 || (d & (d - 1))) {
+            fprintf(stderr, "IN_FIFO / OUT_FIFO must be 0 or a power of two, 2..64\n");
+            return 2;
+        }
+    }
+    if (out_mode < 0 || out_mode > 2) {
+        fprintf(stderr, "OUT_MODE must be 0, 1 or 2\n");
+        return 2;
+    }
+    if (stream_block < 1 || (stream_block & (stream_block - 1))) {
+        fprintf(stderr, "TB_BLOCK must be a power of two\n");
+        return 2;
+    }
+    if (surv != 0 && (surv < 8 || (surv & (surv - 1)))) {
+        fprintf(stderr, "SURV_DEPTH must be 0 or a power of two, at least 8\n");
+        return 2;
+    }
+    report(make_config(k, max_frame, acs_par, radix, nbuf, cut, out_mode, surv, regx, pair, pipe,
+                       soft, punct, tail_bite, nctx, in_fifo, out_fifo),
+           num_syms, tm, mhz, trunc, tail_bite != 0, stream_depth, stream_block);
+    return 0;
+}
@@ -0,0 +1,729 @@
+// fsm_model.h
+// Cycle-accurate C++ model of the tt_um_ashvin_viterbi control FSM
+// (src/project.v), for latency / throughput sizing without running RTL.
+//
+// Only the control path is modelled: state, counters and the uo_out status
+// pins, register for register, including the FRAME_BITS counter wrap. The
+// datapath is not, so uio_out is always 0. The model has the same port
+// members as the Verilated top (clk, rst_n, ena, ui_in, uio_in, uo_out,
+// uio_out, uio_oe, eval(), final()), so topdrv::TopDriver<FsmModel> drives
+// it exactly like the RTL. tb_top_verilator.cpp --check-model runs both in
+// lock-step and compares per-frame cycle counts.
+//
+// Config::cut_through models CUT_THROUGH = 1: the ACS states run while the
+// frame's bytes are still arriving, with the same host protocol.
+// Config::out_mode models OUT_MODE 1 (one byte per READ_ACK edge) and 2
+// (drain overlapped with the traceback, last byte first).
+// Config::best_search models BEST_SEARCH: a frame closed with TRUNC
+// (ui_in[1]) on the START edge delivers all frame_len bits instead of
+// frame_len - M. The best-state search itself costs no cycles; a SURV_DEPTH
+// ring or TAIL_BITE turns it on without BEST_SEARCH (best_search()).
+// Config::tail_bite models TAIL_BITE = W: a frame closed with TBITE
+// (ui_in[2]) runs W more ACS passes over the frame first, each with its own
+// S_FIND_BEST and one S_ACS_INIT cycle, and two traceback circles; it too
+// delivers all frame_len bits.
+// Config::surv_depth models SURV_DEPTH: a survivor ring shorter than the
+// frame adds a window traceback (S_FIND_BEST + S_TRACE over the ring)
+// whenever the ring is full. Config::reg_exchange models REG_EXCHANGE = 1:
+// S_TRACE takes one cycle whatever the frame length. Config::tb_pair models
+// TB_PAIR = 1: radix-2 survivor columns in pairs, two traceback steps per
+// S_TRACE cycle, plus one for the unpaired last column of an odd frame.
+// Config::acs_pipe models ACS_PIPE = 1: back-to-back serial sweeps with no
+// S_ACS_COMMIT, which instead drains the pipeline before S_FIND_BEST.
+// Config::soft models SOFT = Q: one soft symbol per input byte instead of
+// four hard ones, so a frame takes four times the bytes. Config::punct
+// models PUNCT: each byte completes as many symbols as its punctured bits or
+// samples finish (punct.h), counted with the pattern offset the frame's
+// earlier bytes left, as depuncture.v does.
+// Config::nbuf = 2 models the ping-pong mode (NBUF = 2): receive, decode and
+// output sides with their own slot pointers, driven by TopDriver::run_chain().
+// Config::nctx > 1 models NCTX: one such slot per channel, the receive side
+// addressed by ui_in[7:5], the decode and drain pointers stepping round robin
+// past empty slots, driven by TopDriver::run_channels().
+// Config::in_fifo / out_fifo model IN_FIFO / OUT_FIFO (NBUF = 2, one
+// channel): input bytes and START queue in front of the receive side, and
+// the drain empties a slot into the output FIFO without waiting for READ_ACK.
+//
+// frame_cycles() is the closed form of the same schedule, for sweeps over
+// K / MAX_FRAME / handshake timing that do not need a cycle loop at all.
+// fsm_model.cpp is the command-line front end.
+
+#ifndef FSM_MODEL_H
+#define FSM_MODEL_H
+
+#include <cstdint>
+
+#include "punct.h"
+
+namespace fsmmodel {
+
+struct Config {
+    int k          = 5;
+    int max_frame  = 32;
+    int frame_bits = 6;   // FRAME_BITS localparam in project.v
+    int acs_par    = 0;   // ACS_PAR: 0 = one state per cycle, P = P butterflies
+    bool acs_pipe  = false;  // ACS_PIPE: pipelined one-state-per-cycle ACS
+    int radix      = 2;   // RADIX: 4 = two symbols per ACS / traceback cycle
+    int nbuf       = 1;   // NBUF: 2 = ping-pong symbol / output buffers
+    int nctx       = 1;   // NCTX: channels (2..8), one ping-pong slot each
+    int in_fifo    = 0;   // IN_FIFO: input FIFO entries, 0 = off (NBUF = 2)
+    int out_fifo   = 0;   // OUT_FIFO: output FIFO bytes, 0 = off (NBUF = 2)
+    bool cut_through = false;  // CUT_THROUGH (NBUF = 1 only)
+    int out_mode   = 0;   // OUT_MODE (NBUF = 1 only)
+    bool best_search = false;  // BEST_SEARCH: TRUNC frames keep their last M bits
+    int tail_bite  = 0;   // TAIL_BITE: warm-up passes of a TBITE frame, 0 = off
+    int surv_depth = 0;   // SURV_DEPTH: survivor ring steps, 0 = MAX_FRAME
+    bool reg_exchange = false; // REG_EXCHANGE: no traceback loop, SURV_DEPTH ignored
+    bool tb_pair   = false;  // TB_PAIR: two radix-2 traceback steps per cycle
+    int soft       = 0;   // SOFT: Q-bit soft symbols, 0 = hard decision
+    int punct      = 0;   // PUNCT: 1 = rate 2/3, 2 = rate 3/4 (punct.h)
+};
+
+// S_ACS cycles per trellis step (NUM_GROUPS in project.v)
+inline unsigned acs_groups(const Config &cfg) {
+    const unsigned S = 1u << (cfg.k - 1);
+    return cfg.acs_par ? S / (2u * (unsigned)cfg.acs_par) : S;
+}
+
+// ACS_PAR = S/2 or RADIX = 4: one cycle per trellis step, no S_ACS_COMMIT
+inline bool acs_full(const Config &cfg) {
+    return cfg.radix == 4 || (cfg.acs_par != 0 && acs_groups(cfg) == 1);
+}
+
+// ACS_PIPE in effect (PIPE in project.v): serial radix-2 sweep only
+inline bool acs_pipe(const Config &cfg) {
+    return cfg.acs_pipe && cfg.acs_par == 0 && cfg.radix == 2;
+}
+
+// Cycles per trellis step: G sweep cycles + commit, or 1 when fully parallel.
+// The pipelined sweep has no commit but two drain cycles per frame
+inline unsigned acs_step_cycles(const Config &cfg) {
+    return acs_full(cfg) ? 1u : acs_pipe(cfg) ? acs_groups(cfg) : acs_groups(cfg) + 1u;
+}
+
+// Symbols consumed per trellis step (S_ACS) and per traceback cycle
+inline unsigned syms_per_step(const Config &cfg) {
+    return cfg.radix == 4 ? 2u : 1u;
+}
+
+// Symbols per input byte: four 2-bit hard symbols or one soft symbol
+// (without PUNCT)
+inline unsigned syms_per_byte(const Config &cfg) {
+    return cfg.soft ? 1u : 4u;
+}
+
+// Symbols completed by the first `bytes` bytes of a frame
+inline unsigned frame_syms(const Config &cfg, unsigned bytes) {
+    if (!cfg.punct) return bytes * syms_per_byte(cfg);
+    int off = 0;
+    return (unsigned)punct_step(cfg.punct, &off, (int)bytes * punct_units_per_byte(cfg.soft));
+}
+
+// Bytes the host sends for num_syms symbols: their kept bits / samples,
+// the last byte zero-padded
+inline unsigned frame_bytes(const Config &cfg, unsigned num_syms) {
+    const unsigned spb = syms_per_byte(cfg);
+    if (!cfg.punct) return (num_syms + spb - 1) / spb;
+    unsigned units = 0;
+    for (unsigned t = 0; t < num_syms; ++t) {
+        const unsigned keep = punct_keep(cfg.punct, (int)t);
+        units += (keep & 1u) + (keep >> 1);
+    }
+    const unsigned upb = (unsigned)punct_units_per_byte(cfg.soft);
+    return (units + upb - 1) / upb;
+}
+
+// Survivor ring columns when SURV_DEPTH windows the traceback (SURV_D in
+// project.v), 0 when the survivor memory holds the whole frame
+inline unsigned surv_window(const Config &cfg) {
+    const unsigned cols = (unsigned)cfg.surv_depth / syms_per_step(cfg);
+    const unsigned full = (unsigned)cfg.max_frame / syms_per_step(cfg);
+    return (!cfg.reg_exchange && cfg.surv_depth != 0 && cols < full) ? cols : 0;
+}
+
+// TB_PAIR in effect (PAIR in project.v): radix-2, whole-frame survivor memory
+inline bool tb_pair(const Config &cfg) {
+    return cfg.tb_pair && cfg.radix == 2 && !cfg.reg_exchange && surv_window(cfg) == 0;
+}
+
+// Best-state search in effect (BEST in project.v): asked for, or needed by
+// the window traceback or the tail-biting decode
+inline bool best_search(const Config &cfg) {
+    return cfg.best_search || surv_window(cfg) != 0 || cfg.tail_bite != 0;
+}
+
+// Warm-up passes of a TBITE frame (TBITE in project.v): 0 without the
+// whole frame's survivors
+inline int tail_bite(const Config &cfg) {
+    return (!cfg.reg_exchange && surv_window(cfg) == 0) ? cfg.tail_bite : 0;
+}
+
+// Survivor columns per traceback step (out_buf bits per S_TRACE cycle)
+inline unsigned tb_cols(const Config &cfg) {
+    return tb_pair(cfg) ? 2u : syms_per_step(cfg);
+}
+
+class FsmModel {
+public:
+    // Same encoding as the localparams in project.v
+    enum State : uint8_t {
+        S_IDLE = 0, S_RECEIVE, S_ACS_INIT, S_ACS, S_ACS_COMMIT,
+        S_FIND_BEST, S_TRACE, S_OUTPUT
+    };
+
+    // Port members, named like the Verilated model
+    uint8_t clk = 0, rst_n = 0, ena = 1;
+    uint8_t ui_in = 0, uio_in = 0;
+    uint8_t uo_out = 0, uio_out = 0, uio_oe = 0;
+
+    explicit FsmModel(const Config &cfg = Config())
+        : cfg_(cfg), m_(cfg.k - 1), num_groups_(acs_groups(cfg)),
+          fmask_((1u << cfg.frame_bits) - 1), win_(surv_window(cfg)) {
+        do_reset();
+        update_outputs();
+    }
+
+    void eval() {
+        if (clk && !last_clk_) posedge();
+        last_clk_ = clk;
+        update_outputs();
+    }
+    void final() {}
+
+    State    state()       const { return state_; }
+    bool     multi()       const { return cfg_.nctx > 1; }
+    bool     pingpong()    const { return cfg_.nbuf == 2 || multi(); }
+    unsigned nslot()       const { return multi() ? (unsigned)cfg_.nctx : 2u; }
+    bool     ififo()       const { return cfg_.in_fifo && pingpong() && !multi(); }
+    bool     ofifo()       const { return cfg_.out_fifo && pingpong() && !multi(); }
+    bool     cut_through() const { return cfg_.cut_through && !pingpong(); }
+    bool     out_stream()  const { return cfg_.out_mode != 0 && !pingpong(); }
+    bool     out_ovl()     const { return cfg_.out_mode == 2 && !pingpong(); }
+    uint64_t edges()       const { return edges_; }
+    unsigned frame_len()   const { return frame_len_; }
+    unsigned out_total()   const { return out_total_; }
+
+private:
+    void do_reset() {
+        state_ = S_IDLE;
+        sym_count_ = frame_len_ = acs_time_ = 0;
+        dp_off_ = 0;
+        sweep_idx_ = tb_time_ = win_base_ = 0;
+        tb_win_ = pend_ = tb_circ_ = false;
+        init_cnt_ = wrap_cnt_ = 0;
+        out_total_ = out_byte_pos_ = 0;
+        frame_done_ = out_byte_valid_ = false;
+        rx_open_ = ob_left_ = frame_trunc_ = frame_tbite_ = false;
+        rx_sel_ = dec_sel_ = out_sel_ = 0;
+        for (int i = 0; i < MAX_SLOT; ++i) {
+            rx_full_[i] = ob_full_[i] = rx_trunc_[i] = rx_tbite_[i] = false;
+            rx_len_[i] = ob_total_[i] = 0;
+            ch_off_[i] = 0;
+        }
+        if_n_ = if_rd_ = of_n_ = 0;
+        of_gap_ = false;
+    }
+
+    // uio_busy in project.v: an output byte is on the pins
+    bool uio_busy() const { return ofifo() ? of_n_ > 0 && !of_gap_ : out_byte_valid_; }
+
+    // rx_nx / dec_nx / out_nx in project.v
+    unsigned next_slot(unsigned s) const { return s + 1 == nslot() ? 0 : s + 1; }
+
+    // Symbols the byte taken on this edge completes; PUNCT advances the
+    // pattern offset (dp_off in project.v), from 0 for a fresh frame
+    unsigned take_byte(bool fresh, int *off = nullptr) {
+        if (!cfg_.punct) return syms_per_byte(cfg_);
+        if (!off) off = &dp_off_;
+        if (fresh) *off = 0;
+        return (unsigned)punct_step(cfg_.punct, off, punct_units_per_byte(cfg_.soft));
+    }
+
+    // NBUF = 2 / NCTX receive and output sides; they read the pre-edge
+    // values of the slot flags, which the decode side may update on the
+    // same edge. chan is ui_in[7:5]
+    void posedge_pingpong(bool byte_valid, bool start_cmd, bool trunc_cmd, bool tbite_cmd,
+                          bool read_ack, unsigned chan, const bool rx_full[],
+                          const bool ob_full[]) {
+        const unsigned mf = (unsigned)cfg_.max_frame;
+        const bool busy = uio_busy();
+        const unsigned od = (unsigned)cfg_.out_fifo;
+        const bool of_push = ofifo() && out_byte_valid_ && of_n_ < od;
+        const bool of_pop  = ofifo() && read_ack && busy;
+        // in_room in project.v: BYTE_VALID with room holds uio released
+        const bool in_room = ififo() ? if_n_ + 1 < (unsigned)cfg_.in_fifo : !rx_full[rx_sel_];
+
+        if (multi()) {
+            const bool ok = chan < nslot();
+            const bool ready = ok && !rx_full[chan] && !busy;
+            if (start_cmd && ok && !rx_full[chan] && rx_len_[chan] > 0) {
+                rx_full_[chan] = true;
+                rx_trunc_[chan] = trunc_cmd;
+                rx_tbite_[chan] = tbite_cmd;
+                ch_off_[chan] = 0;
+            } else if (byte_valid && ready && rx_len_[chan] < mf) {
+                const unsigned n = take_byte(false, &ch_off_[chan]);
+                rx_len_[chan] = (rx_len_[chan] + n <= mf) ? rx_len_[chan] + n : (mf & fmask_);
+            }
+        } else {
+            // pp_start / pp_byte in project.v: the pins, or the input
+            // FIFO's head once the slot is free
+            bool start = start_cmd, trunc = trunc_cmd, tbite = tbite_cmd;
+            bool take = byte_valid && !rx_full[rx_sel_] && !busy;
+            if (ififo()) {
+                const unsigned d = (unsigned)cfg_.in_fifo;
+                const uint8_t head = if_q_[if_rd_];
+                const bool pop = if_n_ > 0 && !rx_full[rx_sel_];
+                start = if_n_ > 0 && (head & 1);
+                trunc = head & 2;
+                tbite = head & 4;
+                take  = pop && !(head & 1);
+                // bytes leave the last entry for START
+                if (start_cmd ? if_n_ < d : byte_valid && !busy && if_n_ + 1 < d) {
+                    if_q_[(if_rd_ + if_n_) % d] =
+                        (uint8_t)((start_cmd ? 1 : 0) | (trunc_cmd ? 2 : 0) | (tbite_cmd ? 4 : 0));
+                    ++if_n_;
+                }
+                if (pop) {
+                    if_rd_ = (if_rd_ + 1) % d;
+                    --if_n_;
+                }
+            }
+            if (start && !rx_full[rx_sel_] && sym_count_ > 0) {
+                rx_full_[rx_sel_] = true;
+                rx_len_[rx_sel_] = sym_count_;
+                rx_trunc_[rx_sel_] = trunc;
+                rx_tbite_[rx_sel_] = tbite;
+                rx_sel_ = next_slot(rx_sel_);
+                sym_count_ = 0;
+                dp_off_ = 0;
+            } else if (take && sym_count_ < mf) {
+                const unsigned n = take_byte(false);
+                sym_count_ = (sym_count_ + n <= mf) ? sym_count_ + n : (mf & fmask_);
+            }
+        }
+
+        if (!out_byte_valid_) {
+            if (ob_full[out_sel_]) {
+                if (out_byte_pos_ < ob_total_[out_sel_]) {
+                    out_byte_valid_ = true;
+                } else {
+                    ob_full_[out_sel_] = false;
+                    out_byte_pos_ = 0;
+                    out_sel_ = next_slot(out_sel_);
+                }
+            } else if (multi()) {
+                out_sel_ = next_slot(out_sel_);
+            }
+        } else if (ofifo() ? of_n_ < od : read_ack) {
+            out_byte_valid_ = false;
+            out_byte_pos_ = (out_byte_pos_ + 8 >= ob_total_[out_sel_])
+                                ? ob_total_[out_sel_] : ((out_byte_pos_ + 8) & fmask_);
+        }
+        of_n_ = of_n_ + (of_push ? 1 : 0) - (of_pop ? 1 : 0);
+        of_gap_ = of_pop || (ofifo() && byte_valid && in_room);
+    }
+
+    void posedge() {
+        ++edges_;
+        if (!rst_n) { do_reset(); return; }
+
+        // PIPE: a state issued on the previous edge is in the ACS stage
+        const bool acs_pend = pend_;
+        pend_ = false;
+
+        const bool byte_valid = ui_in & 0x01;
+        const bool trunc_cmd  = ui_in & 0x02;
+        const bool tbite_cmd  = ui_in & 0x04;
+        const bool start_cmd  = ui_in & 0x08;
+        const bool read_ack   = ui_in & 0x10;
+        const unsigned mf     = (unsigned)cfg_.max_frame;
+
+        if (pingpong()) {
+            bool rx_full[MAX_SLOT], ob_full[MAX_SLOT];
+            for (int i = 0; i < MAX_SLOT; ++i) {
+                rx_full[i] = rx_full_[i];
+                ob_full[i] = ob_full_[i];
+            }
+            const unsigned dec = dec_sel_;
+            posedge_pingpong(byte_valid, start_cmd, trunc_cmd, tbite_cmd, read_ack,
+                             (unsigned)ui_in >> 5, rx_full, ob_full);
+            switch (state_) {
+            case S_IDLE:
+                if (rx_full[dec] && !ob_full[dec]) {
+                    frame_len_ = rx_len_[dec];
+                    frame_trunc_ = rx_trunc_[dec];
+                    frame_tbite_ = rx_tbite_[dec];
+                    init_cnt_ = 0;
+                    state_ = S_ACS_INIT;
+                } else if (multi()) {
+                    dec_sel_ = next_slot(dec);
+                }
+                return;
+            case S_FIND_BEST:
+                if (!tb_win_ && !wrap_due()) {
+                    rx_full_[dec] = false;
+                    if (multi()) rx_len_[dec] = 0;
+                }
+                break;
+            case S_TRACE:
+                if (!tb_win_ && !tb_circ_ && (cfg_.reg_exchange || tb_time_ == win_base_)) {
+                    ob_full_[dec] = true;
+                    ob_total_[dec] = frame_bits();
+                    dec_sel_ = next_slot(dec);
+                    state_ = S_IDLE;
+                    return;
+                }
+                break;
+            default:
+                break;
+            }
+        }
+
+        // CT receive side; the ACS states below see the pre-edge values
+        const bool     rx_open   = rx_open_;
+        const unsigned sym_count = sym_count_;
+        const unsigned spc       = syms_per_step(cfg_);
+        const bool     acs_go    = !cut_through() || acs_time_ * spc + spc - 1 < sym_count ||
+                                   (!rx_open && acs_time_ * spc < sym_count);
+        if (rx_open) {
+            if (start_cmd) {
+                frame_len_ = sym_count;
+                frame_trunc_ = trunc_cmd;
+                frame_tbite_ = tbite_cmd;
+                rx_open_ = false;
+            } else if (byte_valid && sym_count < mf) {
+                const unsigned n = take_byte(false);
+                sym_count_ = (sym_count + n <= mf) ? sym_count + n : (mf & fmask_);
+            }
+        }
+
+        // OUT_OVL drain, against the pre-edge traceback position
+        const bool obv_q = out_byte_valid_, ob_left_q = ob_left_;
+        if (out_ovl() && (state_ == S_TRACE || state_ == S_OUTPUT) &&
+            (!out_byte_valid_ || read_ack)) {
+            const unsigned tb_bit = tb_time_ * tb_cols(cfg_);
+            if (ob_left_ && (state_ == S_OUTPUT || (!tb_circ_ && tb_bit < out_byte_pos_))) {
+                out_byte_valid_ = true;
+                if (out_byte_pos_ == 0) ob_left_ = false;
+                else out_byte_pos_ -= 8;
+            } else {
+                out_byte_valid_ = false;
+            }
+        }
+
+        switch (state_) {
+        case S_IDLE:
+            frame_done_ = false;
+            out_byte_valid_ = false;
+            sym_count_ = 0;
+            if (byte_valid) {
+                sym_count_ = take_byte(true);
+                if (cut_through()) {
+                    rx_open_ = true;
+                    init_cnt_ = 0;
+                    state_ = S_ACS_INIT;
+                } else {
+                    state_ = S_RECEIVE;
+                }
+            }
+            break;
+
+        case S_RECEIVE: {
+            out_byte_valid_ = false;
+            unsigned next_count = sym_count_;
+            if (byte_valid && sym_count_ < mf) {
+                const unsigned n = take_byte(false);
+                next_count = (sym_count_ + n <= mf) ? sym_count_ + n : (mf & fmask_);
+            }
+            if (start_cmd && sym_count_ > 0) {
+                frame_len_ = sym_count_;
+                frame_trunc_ = trunc_cmd;
+                frame_tbite_ = tbite_cmd;
+                init_cnt_ = 0;
+                state_ = S_ACS_INIT;
+            }
+            sym_count_ = next_count;
+            break;
+        }
+
+        case S_ACS_INIT:
+            if (init_cnt_ < 2) {
+                if (init_cnt_ == 0) wrap_cnt_ = 0;
+                ++init_cnt_;
+            } else {
+                acs_time_ = 0;
+                sweep_idx_ = 0;
+                win_base_ = 0;
+                tb_win_ = false;
+                state_ = S_ACS;
+            }
+            break;
+
+        case S_ACS:
+            if (!acs_go) {
+                if (!rx_open) state_ = acs_pipe(cfg_) ? S_ACS_COMMIT : S_FIND_BEST;
+            } else if (win_ && acs_time_ - win_base_ == win_) {
+                tb_win_ = true;
+                state_ = acs_pipe(cfg_) ? S_ACS_COMMIT : S_FIND_BEST;
+            } else if (acs_pipe(cfg_)) {
+                pend_ = true;
+                if (sweep_idx_ == num_groups_ - 1) {
+                    sweep_idx_ = 0;
+                    if (acs_time_ == acs_last() && !rx_open) state_ = S_ACS_COMMIT;
+                    else acs_time_ = (acs_time_ + 1) & fmask_;
+                } else {
+                    ++sweep_idx_;
+                }
+            } else if (acs_full(cfg_)) {
+                if (acs_time_ == acs_last() && !rx_open) state_ = S_FIND_BEST;
+                else acs_time_ = (acs_time_ + 1) & fmask_;
+            } else if (sweep_idx_ == num_groups_ - 1) {
+                state_ = S_ACS_COMMIT;
+            } else {
+                ++sweep_idx_;
+            }
+            break;
+
+        case S_ACS_COMMIT:
+            if (acs_pipe(cfg_)) {
+                if (!acs_pend) state_ = S_FIND_BEST;
+            } else if (acs_time_ == frame_len_ - 1 && !rx_open) {
+                state_ = S_FIND_BEST;
+            } else {
+                acs_time_ = (acs_time_ + 1) & fmask_;
+                sweep_idx_ = 0;
+                state_ = S_ACS;
+            }
+            break;
+
+        case S_FIND_BEST:
+            if (!tb_win_ && wrap_due()) {
+                ++wrap_cnt_;
+                init_cnt_ = 2;
+                state_ = S_ACS_INIT;
+                break;
+            }
+            state_ = S_TRACE;
+            if (tb_win_) {
+                tb_time_ = (acs_time_ - 1) & fmask_;
+                break;
+            }
+            tb_time_ = tb_last();
+            tb_circ_ = tbite_on();
+            if (out_ovl()) {
+                out_total_ = frame_bits();
+                out_byte_pos_ = ((out_total_ - 1) & ~7u) & fmask_;
+                ob_left_ = out_total_ != 0;
+            }
+            break;
+
+        case S_TRACE:
+            if (tb_win_ && tb_time_ == win_base_) {
+                win_base_ = (win_base_ + win_ / 4) & fmask_;
+                tb_win_ = false;
+                state_ = S_ACS;
+            } else if (tb_circ_ && tb_time_ == win_base_) {
+                tb_circ_ = false;
+                tb_time_ = tb_last();
+            } else if (cfg_.reg_exchange || tb_time_ == win_base_) {
+                if (!out_ovl()) {
+                    out_total_ = frame_bits();
+                    out_byte_pos_ = 0;
+                    out_byte_valid_ = false;
+                }
+                state_ = S_OUTPUT;
+            } else {
+                --tb_time_;
+            }
+            break;
+
+        case S_OUTPUT:
+            if (out_ovl()) {
+                if (!ob_left_q && !obv_q) {
+                    frame_done_ = true;
+                    if (start_cmd) state_ = S_IDLE;
+                }
+            } else if (out_stream()) {
+                if (!out_byte_valid_ || read_ack) {
+                    if (out_byte_pos_ < out_total_) {
+                        out_byte_valid_ = true;
+                        out_byte_pos_ = (out_byte_pos_ + 8 >= out_total_)
+                                            ? out_total_ : ((out_byte_pos_ + 8) & fmask_);
+                    } else {
+                        if (!out_byte_valid_) {
+                            frame_done_ = true;
+                            if (start_cmd) state_ = S_IDLE;
+                        }
+                        out_byte_valid_ = false;
+                    }
+                }
+            } else if (!out_byte_valid_) {
+                if (out_byte_pos_ < out_total_) {
+                    out_byte_valid_ = true;
+                } else {
+                    frame_done_ = true;
+                    if (start_cmd) state_ = S_IDLE;
+                }
+            } else if (read_ack) {
+                out_byte_valid_ = false;
+                out_byte_pos_ = (out_byte_pos_ + 8 >= out_total_) ? out_total_
+                                                                 : ((out_byte_pos_ + 8) & fmask_);
+            }
+            break;
+        }
+    }
+
+    // tbite_on in project.v, and a warm-up pass still to run
+    bool tbite_on() const { return tail_bite(cfg_) && frame_tbite_; }
+    bool wrap_due() const { return tbite_on() && wrap_cnt_ != (unsigned)tail_bite(cfg_); }
+
+    // frame_bits in project.v
+    unsigned frame_bits() const {
+        if ((best_search(cfg_) && frame_trunc_) || tbite_on()) return frame_len_;
+        return frame_len_ > (unsigned)m_ ? frame_len_ - (unsigned)m_ : 0;
+    }
+
+    // acs_last in project.v: an odd radix-4 frame ends with a half step
+    unsigned acs_last() const {
+        return ((frame_len_ - 1) / syms_per_step(cfg_)) & fmask_;
+    }
+
+    // tb_last in project.v: the traceback's first survivor word
+    unsigned tb_last() const {
+        return tb_pair(cfg_) ? acs_last() >> 1 : acs_last();
+    }
+
+    void update_outputs() {
+        bool busy  = state_ != S_IDLE && state_ != S_RECEIVE && state_ != S_OUTPUT;
+        bool ready = state_ == S_IDLE || state_ == S_RECEIVE || rx_open_;
+        bool done  = frame_done_;
+        unsigned tag = 0;
+        if (pingpong()) {
+            // NCTX: BYTE_IN_READY of the channel on ui_in[7:5]
+            const unsigned rx = multi() ? (unsigned)ui_in >> 5 : rx_sel_;
+            const unsigned id = (unsigned)cfg_.in_fifo, od = (unsigned)cfg_.out_fifo;
+            ready = rx < nslot() && (ififo() ? if_n_ + 1 < id : !rx_full_[rx]) && !uio_busy();
+            busy  = state_ != S_IDLE;
+            done  = state_ == S_IDLE && !out_byte_valid_ && if_n_ == 0 && of_n_ == 0;
+            for (unsigned i = 0; i < nslot(); ++i)
+                done = done && !rx_full_[i] && !ob_full_[i];
+            // Tag, or the FIFO flags (sync_fifo: a quarter from either end)
+            if (multi())
+                tag = out_sel_ << 5;
+            else
+                tag = (ififo() && if_n_ >= id - id / 4 ? 0x20 : 0) |
+                      (ififo() && if_n_ <= id / 4 ? 0x40 : 0) |
+                      (ofifo() && of_n_ >= od - od / 4 ? 0x80 : 0);
+        }
+        const bool out_valid = pingpong() ? uio_busy() : out_byte_valid_;
+        uo_out = (uint8_t)((ready ? 0x01 : 0) | (out_valid ? 0x02 : 0) |
+                           (busy ? 0x08 : 0) | (done ? 0x10 : 0) | tag);
+        uio_out = 0;
+        uio_oe  = out_valid ? 0xFF : 0x00;
+    }
+
+    Config   cfg_;
+    int      m_;
+    unsigned num_groups_;
+    unsigned fmask_;
+    unsigned win_;
+
+    State    state_ = S_IDLE;
+    unsigned sym_count_ = 0, frame_len_ = 0, acs_time_ = 0;
+    int      dp_off_ = 0;
+    unsigned sweep_idx_ = 0, tb_time_ = 0, init_cnt_ = 0, wrap_cnt_ = 0;
+    unsigned win_base_ = 0;
+    bool     tb_win_ = false, pend_ = false, tb_circ_ = false;
+    unsigned out_total_ = 0, out_byte_pos_ = 0;
+    bool     frame_done_ = false, out_byte_valid_ = false;
+    bool     rx_open_ = false, ob_left_ = false, frame_trunc_ = false, frame_tbite_ = false;
+    // Ping-pong / NCTX slots; NCTX uses rx_len_ as the channel's count
+    static constexpr int MAX_SLOT = 8;
+    unsigned rx_sel_ = 0, dec_sel_ = 0, out_sel_ = 0;
+    bool     rx_full_[MAX_SLOT] = {}, ob_full_[MAX_SLOT] = {};
+    bool     rx_trunc_[MAX_SLOT] = {}, rx_tbite_[MAX_SLOT] = {};
+    unsigned rx_len_[MAX_SLOT] = {}, ob_total_[MAX_SLOT] = {};
+    int      ch_off_[MAX_SLOT] = {};
+    // IN_FIFO entries (bit 0 START, 1 TRUNC, 2 TBITE; the byte itself is not
+    // modelled) from if_rd_, and the OUT_FIFO fill level
+    static constexpr int MAX_FIFO = 64;
+    uint8_t  if_q_[MAX_FIFO] = {};
+    unsigned if_n_ = 0, if_rd_ = 0, of_n_ = 0;
+    bool     of_gap_ = false;
+    uint8_t  last_clk_ = 0;
+    uint64_t edges_ = 0;
+};
+
+// Continuous mode (viterbi_stream, CONTINUOUS = 1) with traceback depth D
+// and TB_BLOCK = B: cycles per symbol once the pipeline is full and the host
+// never stalls. The S-cycle ACS sweeps of a block overlap the (D + B - 1)-step
+// traceback pass of the previous one, so the slower of the two sets the rate.
+inline double stream_cycles_per_symbol(const Config &cfg, unsigned depth, unsigned block = 1) {
+    const unsigned S = 1u << (cfg.k - 1);
+    const unsigned acs = block * (S + 2), tb = depth + block + 2;
+    return (double)(acs > tb ? acs : tb) / block;
+}
+
+// Per-frame cycle budget under topdrv::TopDriver::run_frame().
+struct FrameCycles {
+    uint64_t receive;   // first byte offered .. START accepted
+    uint64_t decode;    // START accepted .. first BYTE_OUT_VALID seen
+    uint64_t drain;     // first output byte .. FSM back in S_IDLE
+    uint64_t total;     // = receive + decode + drain = FrameResult::cycles
+    unsigned out_bits;  // decoded bits the frame delivers (frame_len - M,
+                        // all frame_len with TRUNC or TBITE)
+};
+
+// Closed form of the FsmModel schedule driven by TopDriver with
+// byte_gap / start_gap / ack_delay host timing, for a frame of num_syms
+// symbols starting from S_IDLE, closed with TRUNC if trunc and TBITE if
+// tbite. Valid while the frame fits in MAX_FRAME and delivers at least one
+// bit. Not valid for CUT_THROUGH or OUT_MODE 2, whose overlap depends on
+// the host timing.
+inline FrameCycles frame_cycles(const Config &cfg, unsigned num_syms,
+                                unsigned byte_gap = 0, unsigned start_gap = 0,
+                                unsigned ack_delay = 0, bool trunc = false,
+                                bool tbite = false) {
+    const uint64_t step  = acs_step_cycles(cfg);
+    const unsigned spc   = syms_per_step(cfg);
+    const unsigned bytes = frame_bytes(cfg, num_syms);
+    unsigned L = frame_syms(cfg, bytes);
+    if (L > (unsigned)cfg.max_frame) L = (unsigned)cfg.max_frame;
+    const unsigned wrap  = tbite ? (unsigned)tail_bite(cfg) : 0;
+    const unsigned out_bits = ((trunc && best_search(cfg)) || wrap) ? L : L - (unsigned)(cfg.k - 1);
+    const uint64_t out_bytes = (out_bits + 7) / 8;
+
+    FrameCycles c;
+    // one edge per byte plus host gaps, then the START pulse edge
+    c.receive = (uint64_t)bytes * (1 + byte_gap) + start_gap + 1;
+    // ACS_INIT(3) + ceil(L/spc) steps + FIND_BEST(1) + TRACE + valid(1).
+    // A survivor ring of W < L/spc columns first pauses for ceil((C - W) / B)
+    // window tracebacks of W + 2 cycles, each retiring B = W/4 columns.
+    // Register exchange: TRACE is one cycle; TB_PAIR: ceil(L / 2).
+    // ACS_PIPE: two S_ACS_COMMIT drain cycles, and one per window.
+    // Tail-biting: W warm-up passes of FIND_BEST(1) + ACS_INIT(1) + the
+    // steps, and a second traceback circle
+    const unsigned cols = (L + spc - 1) / spc, win = surv_window(cfg);
+    const unsigned nwin = (win && cols > win) ? (cols - win + win / 4 - 1) / (win / 4) : 0;
+    const unsigned trace = cfg.reg_exchange ? 1 : tb_pair(cfg) ? (cols + 1) / 2
+                                                 : cols - nwin * (win / 4);
+    const unsigned drain = acs_pipe(cfg) ? 1 : 0;
+    c.decode  = 3 + (uint64_t)cols * step + 2 * drain + 1 + trace + 1 +
+                (uint64_t)nwin * (win + 2 + drain) +
+                (wrap ? wrap * (2 + (uint64_t)cols * step + 2 * drain) + trace : 0);
+    // per byte: ack_delay + ack edge + edge re-asserting valid (the last one
+    // raises frame_done instead), then the START edge back to S_IDLE.
+    // OUT_MODE 1 loads the next byte on the ack edge itself.
+    if (cfg.out_mode == 1 && cfg.nbuf != 2)
+        c.drain = out_bytes * (ack_delay + 1) + 2;
+    else
+        c.drain = out_bytes * (ack_delay + 2) + 1;
+    c.total   = c.receive + c.decode + c.drain;
+    c.out_bits = out_bits;
+    return c;
+}
+
+}  // namespace fsmmodel
+
+#endif  // FSM_MODEL_H
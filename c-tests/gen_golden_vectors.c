@@ -7,6 +7,14 @@
  * Build example:
  *   gcc -DK=5 -DG0_OCT=023 -DG1_OCT=035 -o gen_golden gen_golden_vectors.c
  *   ./gen_golden > golden_k5.json
+ *
+ * Options:
+ *   -b FILE   write the binary format described in golden_vectors.h
+ *             instead of JSON on stdout
+ *   -s SEED   PRBS-7 seed for the pseudo-random vectors (default 1) and
+ *             seed for the -r frames
+ *   -r N      append N random frames (random length and data, every
+ *             fourth one with two symbol bit flips)
  */
 
 #include <stdint.h>
@@ -15,6 +23,8 @@
 #include <string.h>
 #include <limits.h>
 
+#include "golden_vectors.h"
+
 /* ---------- compile-time parameters ---------- */
 
 #ifndef K
@@ -31,7 +41,9 @@
 
 #define M       (K - 1)
 #define STATES  (1 << M)
+#ifndef MAX_FRAME
 #define MAX_FRAME 32          /* max symbols including tails */
+#endif
 #define MAX_DATA  (MAX_FRAME - M)
 
 /* ================================================================
@@ -166,13 +178,15 @@ static int viterbi_decode(const uint8_t *rx_syms, int T, uint8_t *out_bits) {
 }
 
 /* ================================================================
- * PRBS-7 generator: x^7 + x^6 + 1, seed=0x01
+ * PRBS-7 generator: x^7 + x^6 + 1, seed=0x01 unless -s is given
  * Taps at bits 6 and 5 (0-indexed).
  * Output = LSB of state each step.
  * ================================================================ */
 
+static uint32_t prbs7_seed = 0x01;
+
 static void prbs7_generate(uint8_t *out, int count) {
-    uint32_t state = 0x01;
+    uint32_t state = prbs7_seed;
     for (int i = 0; i < count; ++i) {
         out[i] = (uint8_t)(state & 1u);
         uint32_t new_bit = ((state >> 6) ^ (state >> 5)) & 1u;
@@ -185,7 +199,7 @@ static void prbs7_generate(uint8_t *out, int count) {
  * ================================================================ */
 
 typedef struct {
-    const char *name;
+    char        name[GV_NAME_LEN + 1];
     int         noisy;
     int         num_data_bits;
     uint8_t     bits[MAX_DATA];
@@ -198,7 +212,7 @@ typedef struct {
 /* Encode a clean vector: fill bits[], symbols[], decoded[] */
 static void make_clean_vector(test_vector_t *v, const char *name,
                               const uint8_t *data, int N) {
-    v->name = name;
+    snprintf(v->name, sizeof(v->name), "%s", name);
     v->noisy = 0;
     v->num_data_bits = N;
     memcpy(v->bits, data, N);
@@ -216,7 +230,7 @@ static void make_noisy_vector(test_vector_t *v, const char *name,
                               const int *flip_sym_idx,
                               const int *flip_bit_pos,
                               int num_flips) {
-    v->name = name;
+    snprintf(v->name, sizeof(v->name), "%s", name);
     v->noisy = 1;
     v->num_data_bits = N;
     memcpy(v->bits, data, N);
@@ -281,14 +295,128 @@ static void print_vector_json(const test_vector_t *v, int last) {
 }
 
 /* ================================================================
- * Main: generate all 25 test vectors and print JSON
+ * Binary output (format in golden_vectors.h)
+ * ================================================================ */
+
+static void put_u16(FILE *f, uint32_t v) {
+    fputc(v & 0xFF, f);
+    fputc((v >> 8) & 0xFF, f);
+}
+
+static void put_u32(FILE *f, uint32_t v) {
+    put_u16(f, v & 0xFFFFu);
+    put_u16(f, v >> 16);
+}
+
+static void put_padded(FILE *f, const uint8_t *arr, int len, uint8_t mask) {
+    for (int i = 0; i < MAX_FRAME; ++i)
+        fputc(i < len ? (arr[i] & mask) : 0, f);
+}
+
+static int write_vectors_bin(const char *path, const test_vector_t *tests,
+                             int num_tests, uint32_t seed) {
+    FILE *f = fopen(path, "wb");
+    if (!f) { perror(path); return -1; }
+
+    fwrite(GV_MAGIC, 1, 4, f);
+    put_u16(f, K);
+    put_u16(f, M);
+    put_u16(f, G0_OCT);
+    put_u16(f, G1_OCT);
+    put_u16(f, MAX_FRAME);
+    put_u16(f, 0);
+    put_u32(f, (uint32_t)num_tests);
+    put_u32(f, seed);
+    put_u32(f, GV_RECORD_FIXED + 3u * MAX_FRAME);
+    put_u32(f, 0);
+
+    for (int i = 0; i < num_tests; ++i) {
+        const test_vector_t *v = &tests[i];
+        char name[GV_NAME_LEN];
+        size_t len = strlen(v->name);
+        memset(name, 0, sizeof(name));
+        memcpy(name, v->name, len < GV_NAME_LEN ? len : GV_NAME_LEN);
+        fwrite(name, 1, GV_NAME_LEN, f);
+        fputc(v->noisy ? 1 : 0, f);
+        fputc(0, f);
+        put_u16(f, (uint32_t)v->num_data_bits);
+        put_u16(f, (uint32_t)v->num_symbols);
+        put_u16(f, (uint32_t)v->num_decoded);
+        put_padded(f, v->bits, v->num_data_bits, 1u);
+        put_padded(f, v->symbols, v->num_symbols, 3u);
+        put_padded(f, v->decoded, v->num_decoded, 1u);
+    }
+
+    if (fclose(f) != 0) { perror(path); return -1; }
+    return 0;
+}
+
+/* ================================================================
+ * Seeded random frames (-r N)
+ * ================================================================ */
+
+static uint32_t xorshift32(uint32_t *s) {
+    uint32_t x = *s;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *s = x;
+}
+
+static void make_random_vector(test_vector_t *v, int n, uint32_t *rng) {
+    uint8_t data[MAX_DATA];
+    char name[GV_NAME_LEN + 1];
+    int N = 1 + (int)(xorshift32(rng) % MAX_DATA);
+
+    for (int i = 0; i < N; ++i)
+        data[i] = (uint8_t)(xorshift32(rng) & 1u);
+
+    snprintf(name, sizeof(name), "rand_%d", n);
+    if ((n & 3) == 3) {
+        int T = N + M;
+        int flip_idx[2], flip_bit[2];
+        for (int i = 0; i < 2; ++i) {
+            flip_idx[i] = (int)(xorshift32(rng) % (uint32_t)T);
+            flip_bit[i] = (int)(xorshift32(rng) & 1u);
+        }
+        make_noisy_vector(v, name, data, N, flip_idx, flip_bit, 2);
+    } else {
+        make_clean_vector(v, name, data, N);
+    }
+}
+
+/* ================================================================
+ * Main: generate the 25 fixed test vectors (plus any -r frames)
+ * and print JSON or write the binary file
  * ================================================================ */
 
 #define NUM_TESTS 25
 
-int main(void) {
-    test_vector_t tests[NUM_TESTS];
-    memset(tests, 0, sizeof(tests));
+static void usage(const char *prog) {
+    fprintf(stderr, "usage: %s [-b out.bin] [-s seed] [-r num_random]\n", prog);
+    exit(2);
+}
+
+int main(int argc, char **argv) {
+    const char *bin_path = NULL;
+    uint32_t seed = 1;
+    int num_random = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "-b") && i + 1 < argc)      bin_path = argv[++i];
+        else if (!strcmp(argv[i], "-s") && i + 1 < argc) seed = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "-r") && i + 1 < argc) num_random = atoi(argv[++i]);
+        else usage(argv[0]);
+    }
+    if (num_random < 0) usage(argv[0]);
+
+    /* PRBS-7 has period 127; map the seed onto a non-zero 7-bit state
+     * (seed 1 keeps the historical 0x01 start) */
+    prbs7_seed = ((seed - 1u) % 127u) + 1u;
+
+    int num_tests = NUM_TESTS + num_random;
+    test_vector_t *tests = (test_vector_t *)calloc((size_t)num_tests, sizeof(test_vector_t));
+    if (!tests) { fprintf(stderr, "OOM tests\n"); return 1; }
 
     int idx = 0;
 
@@ -490,6 +618,22 @@ int main(void) {
                           flip_idx, flip_bit, 1);
     }
 
+    /* ----------------------------------------------------------
+     * Category I: Seeded random frames
+     * ---------------------------------------------------------- */
+
+    {
+        uint32_t rng = seed ? seed : 0x9E3779B9u;
+        for (int n = 0; n < num_random; ++n)
+            make_random_vector(&tests[idx++], n, &rng);
+    }
+
+    if (bin_path) {
+        int rc = write_vectors_bin(bin_path, tests, num_tests, seed);
+        free(tests);
+        return rc ? 1 : 0;
+    }
+
     /* ----------------------------------------------------------
      * Output JSON
      * ---------------------------------------------------------- */
@@ -498,14 +642,16 @@ int main(void) {
     printf("  \"k\": %d,\n", K);
     printf("  \"m\": %d,\n", M);
     printf("  \"max_frame\": %d,\n", MAX_FRAME);
+    printf("  \"seed\": %u,\n", seed);
     printf("  \"tests\": [\n");
 
-    for (int i = 0; i < NUM_TESTS; ++i) {
-        print_vector_json(&tests[i], (i == NUM_TESTS - 1));
+    for (int i = 0; i < num_tests; ++i) {
+        print_vector_json(&tests[i], (i == num_tests - 1));
     }
 
     printf("  ]\n");
     printf("}\n");
 
+    free(tests);
     return 0;
 }
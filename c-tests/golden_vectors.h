@@ -0,0 +1,100 @@
+/*
+ * golden_vectors.h
+ *
+ * Binary golden-vector file format written by `gen_golden_vectors -b`.
+ * All fields are little-endian. Records have a fixed size so that readers
+ * (test/golden_cache.py, the Verilator harness) can mmap the file and index
+ * test i directly at GV_HEADER_SIZE + i * record_size.
+ *
+ * Header (GV_HEADER_SIZE bytes):
+ *   0  char[4]  magic "VGV1"
+ *   4  u16      k
+ *   6  u16      m
+ *   8  u16      g0            (generator value, e.g. 023 octal = 19)
+ *  10  u16      g1
+ *  12  u16      max_frame     (symbols per frame including tail)
+ *  14  u16      reserved
+ *  16  u32      num_tests
+ *  20  u32      seed
+ *  24  u32      record_size
+ *  28  u32      reserved
+ *
+ * Record (record_size = GV_RECORD_FIXED + 3 * max_frame bytes):
+ *   0  char[24] name (NUL padded)
+ *  24  u8       noisy
+ *  25  u8       reserved
+ *  26  u16      num_data_bits
+ *  28  u16      num_symbols
+ *  30  u16      num_decoded
+ *  32  u8[max_frame] bits     (one bit per byte)
+ *      u8[max_frame] symbols  (2-bit symbol per byte, (c0 << 1) | c1)
+ *      u8[max_frame] decoded  (one bit per byte)
+ */
+
+#ifndef GOLDEN_VECTORS_H
+#define GOLDEN_VECTORS_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define GV_MAGIC        "VGV1"
+#define GV_HEADER_SIZE  32
+#define GV_NAME_LEN     24
+#define GV_RECORD_FIXED 32
+
+typedef struct {
+    uint16_t k, m, g0, g1, max_frame;
+    uint32_t num_tests, seed, record_size;
+} gv_header_t;
+
+typedef struct {
+    const char    *name;          /* not NUL terminated if GV_NAME_LEN long */
+    int            noisy;
+    int            num_data_bits;
+    int            num_symbols;
+    int            num_decoded;
+    const uint8_t *bits;
+    const uint8_t *symbols;
+    const uint8_t *decoded;
+} gv_record_t;
+
+static inline uint16_t gv_get_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t gv_get_u32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/* Parse the header of a mapped file. Returns 0 on success. */
+static inline int gv_parse_header(const uint8_t *base, size_t len, gv_header_t *h) {
+    if (len < GV_HEADER_SIZE || memcmp(base, GV_MAGIC, 4) != 0) return -1;
+    h->k           = gv_get_u16(base + 4);
+    h->m           = gv_get_u16(base + 6);
+    h->g0          = gv_get_u16(base + 8);
+    h->g1          = gv_get_u16(base + 10);
+    h->max_frame   = gv_get_u16(base + 12);
+    h->num_tests   = gv_get_u32(base + 16);
+    h->seed        = gv_get_u32(base + 20);
+    h->record_size = gv_get_u32(base + 24);
+    if (h->record_size != GV_RECORD_FIXED + 3u * h->max_frame) return -1;
+    if (len < GV_HEADER_SIZE + (size_t)h->num_tests * h->record_size) return -1;
+    return 0;
+}
+
+/* Point rec at test i of a mapped file whose header is h. */
+static inline void gv_get_record(const uint8_t *base, const gv_header_t *h,
+                                 uint32_t i, gv_record_t *rec) {
+    const uint8_t *r = base + GV_HEADER_SIZE + (size_t)i * h->record_size;
+    rec->name          = (const char *)r;
+    rec->noisy         = r[24];
+    rec->num_data_bits = gv_get_u16(r + 26);
+    rec->num_symbols   = gv_get_u16(r + 28);
+    rec->num_decoded   = gv_get_u16(r + 30);
+    rec->bits          = r + GV_RECORD_FIXED;
+    rec->symbols       = rec->bits + h->max_frame;
+    rec->decoded       = rec->symbols + h->max_frame;
+}
+
+#endif /* GOLDEN_VECTORS_H */
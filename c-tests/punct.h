@@ -0,0 +1,57 @@
+/*
+ * punct.h
+ *
+ * Puncturing patterns of project.v PUNCT (src/depuncture.v), shared by the
+ * C golden model and the C++ harnesses.
+ *
+ *   PUNCT  rate  period  kept {c0, c1} per symbol of the period
+ *     0    1/2     1     11
+ *     1    2/3     2     11 10            (G0: 11, G1: 10)
+ *     2    3/4     3     11 01 10         (G0: 101, G1: 110)
+ *
+ * The channel carries the kept units of each symbol in turn, c1 before c0,
+ * where a unit is a hard bit or, with SOFT = Q, a Q-bit sample. Bytes hold
+ * 8 bits or 2 samples, first unit in the LSBs, so PUNCT = 0 is the usual
+ * {c0, c1} symbol packing. The decoder rebuilds a symbol once its last
+ * kept unit is in and scores punctured bits as erasures (branch metric 0).
+ * The 2/3 pattern keeps c0 in its second symbol: keeping c1 instead makes
+ * the K = 3 (7, 5) code catastrophic.
+ */
+#ifndef PUNCT_H
+#define PUNCT_H
+
+/* Symbols per pattern period */
+static inline int punct_period(int p) {
+    return p == 2 ? 3 : p == 1 ? 2 : 1;
+}
+
+/* Kept bits of symbol t, {c0, c1} like the symbol itself */
+static inline unsigned punct_keep(int p, int t) {
+    static const unsigned keep[3][3] = {{3, 3, 3}, {3, 2, 3}, {3, 1, 2}};
+    return keep[p][t % punct_period(p)];
+}
+
+/* Kept units per period: 2, 3 or 4 */
+static inline int punct_units(int p) {
+    return p == 2 ? 4 : p == 1 ? 3 : 2;
+}
+
+/* Units per input byte */
+static inline int punct_units_per_byte(int q) {
+    return q ? 2 : 8;
+}
+
+/* Symbols completed by n more units, starting *off units into the period
+ * (depuncture.v off); advances *off. */
+static inline int punct_step(int p, int *off, int n) {
+    int syms = 0;
+    for (int i = 0; i < n; ++i) {
+        /* unit 0 of a period holds c1 of the first symbol, every other one
+         * completes a symbol */
+        if (*off != 0) ++syms;
+        *off = (*off + 1) % punct_units(p);
+    }
+    return syms;
+}
+
+#endif /* PUNCT_H */
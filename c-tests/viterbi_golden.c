@@ -3,6 +3,9 @@
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>
+#include <math.h>
+
+#include "punct.h"
 
 #ifndef K
 #define K 5           
@@ -35,6 +38,19 @@ static inline int ham2(uint8_t a, uint8_t b) { // ham2.v
     return (x & 1u) + ((x >> 1) & 1u);
 }
 
+// Branch metric of received symbol r against expected e. q = 0: 2-bit hard
+// symbol, ham2. q > 0: soft symbol (soft_bm.v), two q-bit samples
+// {s1 (c0), s0 (c1)}, 0 a confident 0 and 2^q - 1 a confident 1, each
+// costing its distance from the expected bit. Bits not in keep (punct.h)
+// are erasures and cost nothing (erase_fill.v).
+static inline int sym_bm(uint8_t r, uint8_t e, int q, unsigned keep) {
+    if (!q) return ham2(r & keep, e & keep);
+    const int L = (1 << q) - 1;
+    const int s1 = (r >> q) & L, s0 = r & L;
+    return ((keep & 2u) ? ((e & 2u) ? L - s1 : s1) : 0) +
+           ((keep & 1u) ? ((e & 1u) ? L - s0 : s0) : 0);
+}
+
 // 1) next_state: LSB insertion (new bit into LSB, shift left)
 // LSB insertion (new bit at LSB)
 static inline uint32_t next_state(uint32_t curr_state, uint8_t b, int m){
@@ -54,6 +70,38 @@ static inline uint8_t conv_sym_from_pred(uint32_t p, uint32_t b,
 }
 
 
+// Channel units of symbols syms[0..T-1] under pattern p (punct.h): hard bits
+// for q = 0, q-bit samples otherwise. Returns the number of units.
+int puncture(const uint8_t *syms, int T, int p, int q, uint8_t *units) {
+    const int w = q ? q : 1;
+    const unsigned mask = (1u << w) - 1u;
+    int n = 0;
+    for (int t = 0; t < T; ++t) {
+        const unsigned keep = punct_keep(p, t);
+        if (keep & 1u) units[n++] = (uint8_t)(syms[t] & mask);
+        if (keep & 2u) units[n++] = (uint8_t)((syms[t] >> w) & mask);
+    }
+    return n;
+}
+
+// Inverse of puncture, as depuncture.v: symbols rebuilt from n units,
+// punctured bits 0. A symbol missing its last kept unit is dropped.
+// Returns the number of symbols.
+int depuncture(const uint8_t *units, int n, int p, int q, uint8_t *syms) {
+    const int w = q ? q : 1;
+    int t = 0, i = 0;
+    for (;; ++t) {
+        const unsigned keep = punct_keep(p, t);
+        const int need = (int)(keep & 1u) + (int)((keep >> 1) & 1u);
+        if (i + need > n) break;
+        uint8_t s = 0;
+        if (keep & 1u) s |= units[i++];
+        if (keep & 2u) s |= (uint8_t)(units[i++] << w);
+        syms[t] = s;
+    }
+    return t;
+}
+
 void conv_encode(const uint8_t *in_bits, int N, uint8_t *out_syms, int *T_out) {
     const int m = K - 1;
     const uint32_t g0 = G0_OCT;  // Direct octal
@@ -75,8 +123,73 @@ void conv_encode(const uint8_t *in_bits, int N, uint8_t *out_syms, int *T_out) {
     *T_out = t;
 }
 
+// Tail-biting encode: the register starts with the last m info bits
+// (conv_encoder.v seed_load), so it ends in the state it started from and
+// no tail is sent. T = N symbols.
+void conv_encode_tailbite(const uint8_t *in_bits, int N, uint8_t *out_syms) {
+    const int m = K - 1;
+    uint32_t state = 0;
+    for (int i = 0; i < m && N > 0; ++i)
+        state = next_state(state, in_bits[((N - m + i) % N + N) % N], m);
+    for (int i = 0; i < N; ++i) {
+        uint32_t b = in_bits[i] & 1u;
+        out_syms[i] = conv_sym_from_pred(state, b, G0_OCT, G1_OCT);
+        state = next_state(state, b, m);
+    }
+}
+
+// conv_encode, then puncture to pattern p: *n_out hard channel bits
+void conv_encode_punct(const uint8_t *in_bits, int N, int p, uint8_t *out_bits, int *n_out) {
+    uint8_t *syms = (uint8_t*)malloc((size_t)N + K);
+    if (!syms) { fprintf(stderr, "OOM punct\n"); exit(1); }
+    int T;
+    conv_encode(in_bits, N, syms, &T);
+    *n_out = puncture(syms, T, p, 0, out_bits);
+    free(syms);
+}
+
+// One trellis step over symbol r: new metrics into pm_curr and, if surv is
+// not NULL, the decisions (1: predecessor p1). Ties keep p0.
+static void acs_step(const int *pm_prev, int *pm_curr, uint8_t *surv, uint8_t r, int soft,
+                     unsigned keep) {
+    const int m = K - 1;
+    const int S = 1 << m;
+    for (int s_next = 0; s_next < S; ++s_next) {
+        uint32_t p0 = (uint32_t)(s_next >> 1);
+        uint32_t p1 = (uint32_t)((s_next >> 1) | (1u << (m - 1)));
+        uint8_t b_t = (uint8_t)(s_next & 1u);
+        int m0 = pm_prev[p0] + sym_bm(r, conv_sym_from_pred(p0, b_t, G0_OCT, G1_OCT), soft, keep);
+        int m1 = pm_prev[p1] + sym_bm(r, conv_sym_from_pred(p1, b_t, G0_OCT, G1_OCT), soft, keep);
+        if (surv) surv[s_next] = (uint8_t)(m1 < m0);
+        pm_curr[s_next] = (m1 < m0) ? m1 : m0;
+    }
+}
+
+// Tail-biting warm-up (project.v TAIL_BITE): wrap passes of the ACS over
+// the whole frame from the start metrics, decisions discarded, so the pass
+// that keeps them starts from metrics that have seen the frame's end.
+// Returns the array holding the metrics, pm_prev or pm_curr.
+static int *acs_wrap(int *pm_prev, int *pm_curr, const uint8_t *rx_syms, int T, int wrap,
+                     int soft, int punct) {
+    for (int w = 0; w < wrap; ++w) {
+        for (int t = 0; t < T; ++t) {
+            acs_step(pm_prev, pm_curr, NULL, rx_syms[t], soft, punct_keep(punct, t));
+            int *tmp = pm_prev; pm_prev = pm_curr; pm_curr = tmp;
+        }
+    }
+    return pm_prev;
+}
+
 // Hard-decision Viterbi (traceback). rx_syms length T (2-bit symbols). Returns number of decoded bits (N=T-m).
-int viterbi_decode(const uint8_t *rx_syms, int T, uint8_t *out_bits) {
+// Traceback starts from end_state, or from the best end state if end_state < 0
+// (project.v traces tail-terminated frames from state 0).
+// all_bits: also return the last m bits (the end state's own), N = T.
+// soft: q-bit soft symbols (sym_bm), 0 for hard decision.
+// punct: depunctured symbols of pattern punct (punct.h), 0 for rate 1/2.
+// wrap: tail-biting warm-up passes before the one traced back (acs_wrap),
+// from all-zero start metrics if flat.
+static int viterbi_decode_core(const uint8_t *rx_syms, int T, uint8_t *out_bits, int end_state,
+                               int all_bits, int soft, int punct, int wrap, int flat) {
     const int m = K - 1;
     const int S = 1 << m; // states
     const uint32_t g0 = G0_OCT;  // Direct octal
@@ -96,12 +209,16 @@ int viterbi_decode(const uint8_t *rx_syms, int T, uint8_t *out_bits) {
         if (!surv[t]) { fprintf(stderr, "OOM surv row\n"); exit(1); }
     }
 
-    // Init metrics (start in state 0)
-    for (int s = 0; s < S; ++s) pm_prev[s] = (s == 0) ? 0 : INT_MAX / 4;
+    // Init metrics (start in state 0, or anywhere for a flat tail-biting start)
+    for (int s = 0; s < S; ++s) pm_prev[s] = (s == 0 || flat) ? 0 : INT_MAX / 4;
+    if (acs_wrap(pm_prev, pm_curr, rx_syms, T, wrap, soft, punct) != pm_prev) {
+        int *tmp = pm_prev; pm_prev = pm_curr; pm_curr = tmp;
+    }
 
     // forward pass
     for (int t = 0; t < T; ++t) {
-        uint8_t r = rx_syms[t] & 0x3u;
+        uint8_t r = rx_syms[t];
+        unsigned keep = punct_keep(punct, t);
         for (int s_next = 0; s_next < S; ++s_next) {
 
             uint32_t p0 = (uint32_t)(s_next >> 1);
@@ -112,8 +229,8 @@ int viterbi_decode(const uint8_t *rx_syms, int T, uint8_t *out_bits) {
             uint8_t e0 = conv_sym_from_pred(p0, b_t, g0, g1);
             uint8_t e1 = conv_sym_from_pred(p1, b_t, g0, g1);
 
-            int bm0 = ham2(r, e0);
-            int bm1 = ham2(r, e1);
+            int bm0 = sym_bm(r, e0, soft, keep);
+            int bm1 = sym_bm(r, e1, soft, keep);
 
             int m0 = pm_prev[p0] + bm0;
             int m1 = pm_prev[p1] + bm1;
@@ -135,17 +252,23 @@ int viterbi_decode(const uint8_t *rx_syms, int T, uint8_t *out_bits) {
     for (int s = 1; s < S; ++s) {
         if (pm_prev[s] < bestm) { bestm = pm_prev[s]; s_best = s; }
     }
+    if (end_state >= 0) s_best = end_state & (S - 1);
 
     // Traceback
     // The input length N = T - m (tail bits), output out_bits[0..N-1]
-    int N = T - m;
+    int N = all_bits ? T : T - m;
     int t = T - 1;
     int out_idx = N - 1;
     int s = s_best;
+    // Tail-biting: a first circle only finds the state the best path starts
+    // from, which a tail-biting path also ends in; the real one starts there
+    for (int u = T - 1; wrap && u >= 0; --u)
+        s = surv[u][s] ? (s >> 1) | (1 << (m - 1)) : (s >> 1);
 
     while (t >= 0) {
         uint8_t take_p1 = surv[t][s]; // survivor decision doubles as the decoded input bit
-        if (out_idx >= 0) out_bits[out_idx--] = take_p1;
+        if (all_bits) out_bits[t] = (uint8_t)(s & 1u);  // input bit that led into s
+        else if (out_idx >= 0) out_bits[out_idx--] = take_p1;
 
         if (take_p1)
             s = (s >> 1) | (1u << (m - 1));  // chose predecessor p1
@@ -164,6 +287,130 @@ int viterbi_decode(const uint8_t *rx_syms, int T, uint8_t *out_bits) {
     return N;
 }
 
+int viterbi_decode_from(const uint8_t *rx_syms, int T, uint8_t *out_bits, int end_state) {
+    return viterbi_decode_core(rx_syms, T, out_bits, end_state, 0, 0, 0, 0, 0);
+}
+
+// Unterminated frame (project.v TRUNC): traceback from the best end state,
+// all T input bits out. Returns T.
+int viterbi_decode_trunc(const uint8_t *rx_syms, int T, uint8_t *out_bits) {
+    return viterbi_decode_core(rx_syms, T, out_bits, -1, 1, 0, 0, 0, 0);
+}
+
+// Soft-decision versions (project.v SOFT = q): rx_syms are q-bit sample
+// pairs, see sym_bm / soft_quantize_bpsk.
+int viterbi_decode_soft_from(const uint8_t *rx_syms, int T, uint8_t *out_bits, int end_state,
+                             int q) {
+    return viterbi_decode_core(rx_syms, T, out_bits, end_state, 0, q, 0, 0, 0);
+}
+
+int viterbi_decode_soft_trunc(const uint8_t *rx_syms, int T, uint8_t *out_bits, int q) {
+    return viterbi_decode_core(rx_syms, T, out_bits, -1, 1, q, 0, 0, 0);
+}
+
+// Punctured versions (project.v PUNCT = p): rx_syms from depuncture(), hard
+// (q = 0) or soft, with the punctured bits of pattern p erased.
+int viterbi_decode_punct_from(const uint8_t *rx_syms, int T, uint8_t *out_bits, int end_state,
+                              int q, int p) {
+    return viterbi_decode_core(rx_syms, T, out_bits, end_state, 0, q, p, 0, 0);
+}
+
+int viterbi_decode_punct_trunc(const uint8_t *rx_syms, int T, uint8_t *out_bits, int q, int p) {
+    return viterbi_decode_core(rx_syms, T, out_bits, -1, 1, q, p, 0, 0);
+}
+
+// Tail-biting frame (conv_encode_tailbite; project.v TAIL_BITE = wrap, frame
+// closed with TBITE): wrap >= 1 warm-up passes, then the recorded one,
+// traced back twice from its best end state; all T bits are data. flat
+// starts every state at metric 0 (project.v without CUT_THROUGH, whose
+// first pass runs before the frame is known to be tail-biting and starts in
+// state 0). rx_syms as in viterbi_decode_punct_from. Returns T.
+int viterbi_decode_tailbite(const uint8_t *rx_syms, int T, uint8_t *out_bits, int wrap,
+                            int flat, int q, int p) {
+    return viterbi_decode_core(rx_syms, T, out_bits, -1, 1, q, p, wrap, flat);
+}
+
+int viterbi_decode(const uint8_t *rx_syms, int T, uint8_t *out_bits) {
+    return viterbi_decode_from(rx_syms, T, out_bits, -1);
+}
+
+// Frame decode with a depth-step survivor ring (project.v SURV_DEPTH, with
+// BEST_SEARCH): before step t, once steps base..t-1 fill the ring, trace back
+// from the best state after step t-1 (lowest index on ties) and keep only the
+// bits of the oldest depth/4 steps; base moves past them. The final traceback
+// covers base..T-1, from state 0, or the best state if trunc. Returns the
+// number of bits, as viterbi_decode_from / viterbi_decode_trunc.
+// viterbi_decode_soft_window takes q-bit soft symbols, and
+// viterbi_decode_punct_window depunctured ones of pattern p.
+static int viterbi_decode_window_core(const uint8_t *rx_syms, int T, uint8_t *out_bits,
+                                      int depth, int trunc, int soft, int punct) {
+    const int m = K - 1;
+    const int S = 1 << m;
+    const int blk = depth / 4;
+    const int N = trunc ? T : T - m;
+    uint8_t *bits = (uint8_t*)malloc(T > 0 ? T : 1);
+    int *pm_prev = (int*)malloc(S * sizeof(int));
+    int *pm_curr = (int*)malloc(S * sizeof(int));
+    uint8_t *surv = (uint8_t*)malloc((size_t)(T > 0 ? T : 1) * S);
+    if (!bits || !pm_prev || !pm_curr || !surv) { fprintf(stderr, "OOM window\n"); exit(1); }
+
+    for (int s = 0; s < S; ++s) pm_prev[s] = (s == 0) ? 0 : INT_MAX / 4;
+
+    int base = 0;
+    for (int t = 0; t <= T; ++t) {
+        const int last = (t == T);
+        if (last || t - base == depth) {
+            int s = 0;
+            if (!last || trunc) {
+                for (int i = 1; i < S; ++i)
+                    if (pm_prev[i] < pm_prev[s]) s = i;
+            }
+            const int keep = last ? T : base + blk;
+            for (int u = t - 1; u >= base; --u) {
+                if (u < keep) bits[u] = (uint8_t)(s & 1u);
+                s = surv[(size_t)u * S + s] ? (s >> 1) | (1 << (m - 1)) : (s >> 1);
+            }
+            if (last) break;
+            base += blk;
+        }
+
+        uint8_t r = rx_syms[t];
+        unsigned keep = punct_keep(punct, t);
+        for (int s_next = 0; s_next < S; ++s_next) {
+            uint32_t p0 = (uint32_t)(s_next >> 1);
+            uint32_t p1 = (uint32_t)((s_next >> 1) | (1u << (m - 1)));
+            uint8_t b_t = (uint8_t)(s_next & 1u);
+            int m0 = pm_prev[p0] + sym_bm(r, conv_sym_from_pred(p0, b_t, G0_OCT, G1_OCT), soft, keep);
+            int m1 = pm_prev[p1] + sym_bm(r, conv_sym_from_pred(p1, b_t, G0_OCT, G1_OCT), soft, keep);
+            surv[(size_t)t * S + s_next] = (uint8_t)(m1 < m0);
+            pm_curr[s_next] = (m1 < m0) ? m1 : m0;
+        }
+        int *tmp = pm_prev; pm_prev = pm_curr; pm_curr = tmp;
+    }
+
+    for (int i = 0; i < N; ++i) out_bits[i] = bits[i];
+    free(bits);
+    free(surv);
+    free(pm_prev);
+    free(pm_curr);
+    return N;
+}
+
+int viterbi_decode_window(const uint8_t *rx_syms, int T, uint8_t *out_bits, int depth,
+                          int trunc) {
+    return viterbi_decode_window_core(rx_syms, T, out_bits, depth, trunc, 0, 0);
+}
+
+int viterbi_decode_soft_window(const uint8_t *rx_syms, int T, uint8_t *out_bits, int depth,
+                               int trunc, int q) {
+    return viterbi_decode_window_core(rx_syms, T, out_bits, depth, trunc, q, 0);
+}
+
+int viterbi_decode_punct_window(const uint8_t *rx_syms, int T, uint8_t *out_bits, int depth,
+                                int trunc, int q, int p) {
+    return viterbi_decode_window_core(rx_syms, T, out_bits, depth, trunc, q, p);
+}
+
 // Streaming hard-decision Viterbi matching RTL schedule (one output per symbol)
 // Emits the last survivor bit after a D-step traceback starting at time=wr_ptr-1.
 // Returns T outputs in out_bits[t], where out_bits[t] corresponds to trellis bit at (t-(D-1)).
@@ -252,6 +499,55 @@ int viterbi_decode_streaming(const uint8_t *rx_syms, int T, int D, uint8_t *out_
     return T;
 }
 
+// Streaming decode with block traceback (viterbi_stream TB_BLOCK = B): after
+// every B-th step t (t % B == B - 1), trace back D + B - 1 steps from the
+// best state of step t (lowest index on ties, state 0 if force_state0); the
+// last B bits read are steps t-D-B+2 .. t-D+1. out_bits[u + D - 1] is the bit
+// of step u, as in viterbi_decode_streaming(), which B = 1 reproduces; every
+// bit is decided at depth D or more. Steps before 0 decode as 0. Returns the
+// number of outputs, (T / B) * B.
+int viterbi_decode_streaming_block(const uint8_t *rx_syms, int T, int D, int B,
+                                   uint8_t *out_bits, int force_state0) {
+    const int m = K - 1;
+    const int S = 1 << m;
+    int *pm_prev = (int*)malloc(S * sizeof(int));
+    int *pm_curr = (int*)malloc(S * sizeof(int));
+    uint8_t *surv = (uint8_t*)malloc((size_t)(T > 0 ? T : 1) * S);
+    if (!pm_prev || !pm_curr || !surv) { fprintf(stderr, "OOM block\n"); exit(1); }
+
+    for (int s = 0; s < S; ++s) pm_prev[s] = (s == 0) ? 0 : INT_MAX / 4;
+
+    for (int t = 0; t < T; ++t) {
+        uint8_t r = rx_syms[t] & 0x3u;
+        int bestm = INT_MAX / 4, bests = 0;
+        for (int s_next = 0; s_next < S; ++s_next) {
+            uint32_t p0 = (uint32_t)(s_next >> 1);
+            uint32_t p1 = (uint32_t)((s_next >> 1) | (1u << (m - 1)));
+            uint8_t b_t = (uint8_t)(s_next & 1u);
+            int m0 = pm_prev[p0] + ham2(r, conv_sym_from_pred(p0, b_t, G0_OCT, G1_OCT));
+            int m1 = pm_prev[p1] + ham2(r, conv_sym_from_pred(p1, b_t, G0_OCT, G1_OCT));
+            surv[(size_t)t * S + s_next] = (uint8_t)(m1 < m0);
+            pm_curr[s_next] = (m1 < m0) ? m1 : m0;
+            if (pm_curr[s_next] < bestm) { bestm = pm_curr[s_next]; bests = s_next; }
+        }
+        int *tmp = pm_prev; pm_prev = pm_curr; pm_curr = tmp;
+
+        if (t % B != B - 1) continue;
+        int state = force_state0 ? 0 : bests;
+        for (int k = 0; k < D + B - 1; ++k) {
+            const int u = t - k;
+            const uint8_t bit = (u >= 0) ? surv[(size_t)u * S + state] : 0;
+            if (k >= D - 1) out_bits[u + D - 1] = bit;
+            state = bit ? (state >> 1) | (1 << (m - 1)) : (state >> 1);
+        }
+    }
+
+    free(surv);
+    free(pm_prev);
+    free(pm_curr);
+    return (T / B) * B;
+}
+
 // #define TEST_MAIN
 
 void bsc_hard(uint8_t *syms, int T, double p) {
@@ -271,6 +567,20 @@ static void hard_quantize_bpsk(const double *y0, const double *y1, int T, uint8_
     }
 }
 
+// q-bit soft decision for SOFT = q: sample y maps to floor((1 - y) * 2^(q-1)),
+// clamped to 0 .. 2^q - 1, so +1 (bit 0) lands on 0, -1 (bit 1) on 2^q - 1
+// and the MSB is the hard decision. Packed {q(y0), q(y1)} like sym_bm reads it.
+static void soft_quantize_bpsk(const double *y0, const double *y1, int T, int q, uint8_t *syms_out) {
+    const int L = (1 << q) - 1;
+    for (int t = 0; t < T; ++t) {
+        int s0 = (int)floor((1.0 - y0[t]) * (1 << (q - 1)));
+        int s1 = (int)floor((1.0 - y1[t]) * (1 << (q - 1)));
+        s0 = s0 < 0 ? 0 : s0 > L ? L : s0;
+        s1 = s1 < 0 ? 0 : s1 > L ? L : s1;
+        syms_out[t] = (uint8_t)((s0 << q) | s1);
+    }
+}
+
 static void print_hdr(const char *label) {
     printf("[%s] K=%d  D_TB=%d  G0=%o  G1=%o\n", label, K, D_TB, G0_OCT, G1_OCT);
 }
@@ -278,11 +588,11 @@ static void print_hdr(const char *label) {
 static void run_case(const char *label,
                      const uint8_t *u, int N,
                      const uint8_t *syms_tx, int T,
-                     uint8_t *rx_syms)
+                     uint8_t *rx_syms, int soft, int punct)
 {
     // Decode
     uint8_t *u_hat = (uint8_t*)malloc(N);
-    int Nd = viterbi_decode(rx_syms, T, u_hat);
+    int Nd = viterbi_decode_punct_from(rx_syms, T, u_hat, -1, soft, punct);
 
     // Compare (ignore any mismatch in Nd vs N due to tails; model returns N=T-(K-1))
     int L = (Nd < N) ? Nd : N;
@@ -358,7 +668,7 @@ int main(void) {
 
     // ---- Noiseless sanity check ----
     memcpy(rx_syms, syms_tx, T);                 // exactly what the encoder produced
-    run_case("Noiseless", u, N, syms_tx, T, rx_syms);
+    run_case("Noiseless", u, N, syms_tx, T, rx_syms, 0, 0);
 
 
     // ===============================================================
@@ -367,7 +677,7 @@ int main(void) {
     memcpy(rx_syms, syms_tx, T);
     const double p_bit = 0.1;                     // 3% per coded-bit flip
     bsc_hard(rx_syms, T, p_bit);
-    run_case("BSC", u, N, syms_tx, T, rx_syms);
+    run_case("BSC", u, N, syms_tx, T, rx_syms, 0, 0);
 
     // ===============================================================
     // 2) Gilbert–Elliott — bursty channel (hard-decision)
@@ -380,11 +690,12 @@ int main(void) {
                    0.002,   // p_good: low error in good state
                    0.15);   // p_bad: high error in bad state
     gilbert_elliott(rx_syms, T, &ch);
-    run_case("Gilbert-Elliott", u, N, syms_tx, T, rx_syms);
+    run_case("Gilbert-Elliott", u, N, syms_tx, T, rx_syms, 0, 0);
 
     // ===============================================================
     // 3) AWGN (hard quantized) — BPSK map, add Gaussian noise, threshold back to bits
-    //    Note: hard decisions lose ~2 dB vs soft, but preserves your hard-decision decoder
+    //    Note: hard decisions lose ~2 dB vs soft, but preserves your hard-decision decoder.
+    //    The same samples quantized to 3 bits go through the SOFT = 3 decoder
     // ===============================================================
     {
         memcpy(rx_syms, syms_tx, T);               // just for consistent baseline (we overwrite below)
@@ -394,8 +705,26 @@ int main(void) {
         const double rate = 0.5;                   // r=1/2 code
         awgn_bpsk(syms_tx, T, EbN0_dB, rate, y0, y1);
         hard_quantize_bpsk(y0, y1, T, rx_syms);
+        run_case("AWGN (hard)", u, N, syms_tx, T, rx_syms, 0, 0);
+        soft_quantize_bpsk(y0, y1, T, 3, rx_syms);
         free(y0); free(y1);
-        run_case("AWGN (hard)", u, N, syms_tx, T, rx_syms);
+        run_case("AWGN (soft, 3-bit)", u, N, syms_tx, T, rx_syms, 3, 0);
+    }
+
+    // ===============================================================
+    // 3b) AWGN, rate 3/4 punctured (PUNCT = 2) — only the kept bits are sent,
+    //     at the higher rate's energy per bit; the decoder sees them as erasures
+    // ===============================================================
+    {
+        double *y0 = (double*)malloc(sizeof(double)*T);
+        double *y1 = (double*)malloc(sizeof(double)*T);
+        uint8_t *units = (uint8_t*)malloc(2 * T);
+        awgn_bpsk(syms_tx, T, 5.0, 0.75, y0, y1);
+        hard_quantize_bpsk(y0, y1, T, rx_syms);
+        int n = puncture(rx_syms, T, 2, 0, units);
+        depuncture(units, n, 2, 0, rx_syms);
+        run_case("AWGN (hard, rate 3/4)", u, N, syms_tx, T, rx_syms, 0, 2);
+        free(y0); free(y1); free(units);
     }
 
     // ===============================================================
@@ -412,7 +741,36 @@ int main(void) {
         two_tap_isi_bpsk(syms_tx, T, alpha, EbN0_dB, rate, y0, y1);
         hard_quantize_bpsk(y0, y1, T, rx_syms);
         free(y0); free(y1);
-        run_case("ISI(2-tap)+AWGN (hard)", u, N, syms_tx, T, rx_syms);
+        run_case("ISI(2-tap)+AWGN (hard)", u, N, syms_tx, T, rx_syms, 0, 0);
+    }
+
+    // ===============================================================
+    // 5) Short frames, tail-terminated vs tail-biting (TAIL_BITE = 1), at the
+    //    same energy per info bit: the tail costs M of every Nf + M symbols
+    // ===============================================================
+    {
+        enum { Nf = 32, FRAMES = 400 };
+        uint8_t fu[Nf], fsyms[Nf + K], fhat[Nf + K];
+        double y0[Nf + K], y1[Nf + K];
+        int err_term = 0, err_tb = 0;
+        for (int f = 0; f < FRAMES; ++f) {
+            int Tf;
+            for (int i = 0; i < Nf; ++i) fu[i] = rand() & 1;
+            conv_encode(fu, Nf, fsyms, &Tf);
+            awgn_bpsk(fsyms, Tf, 5.0, 0.5 * Nf / Tf, y0, y1);
+            hard_quantize_bpsk(y0, y1, Tf, fsyms);
+            viterbi_decode_from(fsyms, Tf, fhat, 0);
+            for (int i = 0; i < Nf; ++i) err_term += fhat[i] != fu[i];
+
+            conv_encode_tailbite(fu, Nf, fsyms);
+            awgn_bpsk(fsyms, Nf, 5.0, 0.5, y0, y1);
+            hard_quantize_bpsk(y0, y1, Nf, fsyms);
+            viterbi_decode_tailbite(fsyms, Nf, fhat, 1, 1, 0, 0);
+            for (int i = 0; i < Nf; ++i) err_tb += fhat[i] != fu[i];
+        }
+        print_hdr("AWGN (hard, 32-bit frames)");
+        printf("  %d frames: terminated BER=%.6g, tail-biting BER=%.6g\n\n", FRAMES,
+               (double)err_term / (FRAMES * Nf), (double)err_tb / (FRAMES * Nf));
     }
 
     free(rx_syms);
@@ -0,0 +1,70 @@
+//==============================================================================
+// acs4_core: Radix-4 add-compare-select (two trellis steps at once)
+//==============================================================================
+// The four predecessors of a state two steps back are indexed by x, the two
+// MSBs they differ in (see acs4_unit): x[0] picks the intermediate state,
+// x[1] the predecessor of that intermediate state. Path x costs
+//
+//   T[x] = pm[x] + bm_a[x] + bm_b[x[0]]
+//
+// The select is the radix-2 pair of decisions done in one level: x[1] is
+// decided within each intermediate state first, then x[0] between the two
+// survivors, so ties resolve exactly as two acs_core steps would (lower
+// predecessor wins). All six comparisons run in parallel; the two-step
+// choice is a mux over their results rather than a second compare.
+// pm_mid / dec_mid are the two first-step survivors, one per intermediate
+// state: with bm_b = 0 they are a plain radix-2 step (acs4_unit's half).
+// MODULO = 1 compares wrapping metrics (pm_lt).
+//==============================================================================
+
+`default_nettype none
+
+module acs4_core #(
+    parameter Wm = 8,
+    parameter Wb = 2,
+    parameter MODULO = 0
+) (
+    input  wire [4*Wm-1:0] pm,        // pm[x*Wm +: Wm]
+    input  wire [4*Wb-1:0] bm_a,      // first step, per predecessor x
+    input  wire [2*Wb-1:0] bm_b,      // second step, per intermediate x[0]
+    output wire [Wm-1:0]   pm_out,
+    output wire [1:0]      dec,       // x of the surviving predecessor
+    output wire [2*Wm-1:0] pm_mid,    // survivor into intermediate x[0]
+    output wire [1:0]      dec_mid    // its x[1], per x[0]
+);
+
+  wire [Wm-1:0] t [0:3];
+
+  genvar x;
+  generate
+    for (x = 0; x < 4; x = x + 1) begin : path
+      assign t[x] = pm[x*Wm +: Wm]
+                  + {{(Wm-Wb){1'b0}}, bm_a[x*Wb +: Wb]}
+                  + {{(Wm-Wb){1'b0}}, bm_b[(x%2)*Wb +: Wb]};
+    end
+  endgenerate
+
+  // x[1] per intermediate state (x[0] = 0 and x[0] = 1)
+  wire sel0, sel1;
+  pm_lt #(.Wm(Wm), .MODULO(MODULO)) lt_sel0 (.a(t[2]), .b(t[0]), .lt(sel0));
+  pm_lt #(.Wm(Wm), .MODULO(MODULO)) lt_sel1 (.a(t[3]), .b(t[1]), .lt(sel1));
+
+  // x[0] = 1 wins for each pairing of the two inner choices
+  wire c00, c01, c10, c11;
+  pm_lt #(.Wm(Wm), .MODULO(MODULO)) lt_c00 (.a(t[1]), .b(t[0]), .lt(c00));
+  pm_lt #(.Wm(Wm), .MODULO(MODULO)) lt_c01 (.a(t[1]), .b(t[2]), .lt(c01));
+  pm_lt #(.Wm(Wm), .MODULO(MODULO)) lt_c10 (.a(t[3]), .b(t[0]), .lt(c10));
+  pm_lt #(.Wm(Wm), .MODULO(MODULO)) lt_c11 (.a(t[3]), .b(t[2]), .lt(c11));
+
+  wire x0 = sel1 ? (sel0 ? c11 : c10) : (sel0 ? c01 : c00);
+  wire x1 = x0 ? sel1 : sel0;
+
+  assign dec    = {x1, x0};
+  assign pm_out = t[dec];
+
+  assign dec_mid = {sel1, sel0};
+  assign pm_mid  = {t[{sel1, 1'b1}], t[{sel0, 1'b0}]};
+
+endmodule
+
+`default_nettype wire
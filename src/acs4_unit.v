@@ -0,0 +1,153 @@
+//==============================================================================
+// acs4_unit: Fully parallel radix-4 trellis, two symbols per cycle
+//==============================================================================
+// State s at step t+2 is reached from the four states two steps back
+//
+//   p = {x[1], x[0], s[M-1:2]}   via   q = {x[0], s[M-1:1]}
+//
+// (inputs s[1] then s[0]). Every state gets one acs4_core; the first step
+// is scored against rx_sym0 (symbol t), the second against rx_sym1 (t+1).
+// dec[2s +: 2] = x, the top two bits of the surviving predecessor, so a
+// traceback step is p = {dec, s} >> 2.
+//
+// half makes the cycle a single radix-2 step on rx_sym0, for the odd last
+// symbol of a frame: rx_sym1 is ignored, state s takes the first-step
+// survivor into intermediate state s (computed by state (s << 1) mod S,
+// x[0] = s[M-1]), and dec[2s +: 2] = {0, d} with p = {d, s[M-1:1]}.
+//
+// The S metrics live in one register: init_frame loads state 0 = 0 and the
+// rest the max metric (all 0 with init_flat), wr_en replaces all of them
+// with pm_out.
+//==============================================================================
+
+`default_nettype none
+
+module acs4_unit #(
+    parameter K      = 5,
+    parameter G0_OCT = 'o23,
+    parameter G1_OCT = 'o35,
+    parameter Wm     = 8,
+    parameter Wb     = 2,
+    parameter MODULO = 0,           // wrapping metrics, see pm_lt
+    parameter SOFT   = 0,           // soft symbols, see branch_metric
+    parameter PUNCT  = 0,           // depunctured symbols, see branch_metric
+    parameter M      = K - 1,
+    parameter S      = 1 << M,
+    parameter SW     = (SOFT ? 2 * SOFT : 2) + (PUNCT ? 2 : 0)
+) (
+    input  wire              clk,
+    input  wire              rst,
+    input  wire              init_frame,
+    input  wire              init_flat,
+    input  wire [SW-1:0]     rx_sym0,
+    input  wire [SW-1:0]     rx_sym1,
+    input  wire              half,        // one radix-2 step on rx_sym0
+    input  wire              wr_en,
+
+    output wire [S*Wm-1:0]   pm_out,      // state s at pm_out[s*Wm +: Wm]
+    output wire [2*S-1:0]    dec
+);
+
+  localparam [Wm-1:0]   PM_INF  = MODULO ? {2'b01, {(Wm-2){1'b0}}}
+                                         : {1'b0, {(Wm-1){1'b1}}};
+  localparam [S*Wm-1:0] PM_INIT = {{(S-1){PM_INF}}, {Wm{1'b0}}};
+  // Raw branch-metric width, ham2 or soft_bm, and sample width
+  localparam            RW      = SOFT ? SOFT + 1 : 2;
+  localparam            U       = SOFT ? SOFT : 1;
+
+  reg [S*Wm-1:0] pm_q;
+
+  // Two-step results, and the first-step survivors of every state's pair
+  // of intermediate states
+  wire [S*Wm-1:0]   pm4;
+  wire [2*S-1:0]    dec4;
+  wire [2*S*Wm-1:0] mid_pm;
+  wire [2*S-1:0]    mid_dec;
+
+  always @(posedge clk) begin
+    if (rst)
+      pm_q <= {(S*Wm){1'b0}};
+    else if (init_frame)
+      pm_q <= init_flat ? {(S*Wm){1'b0}} : PM_INIT;
+    else if (wr_en)
+      pm_q <= pm_out;
+  end
+
+  genvar s, x;
+  generate
+    for (s = 0; s < S; s = s + 1) begin : st
+      wire [4*Wm-1:0] pm_x;
+      wire [4*Wb-1:0] bm_a;
+      wire [2*Wb-1:0] bm_b;
+
+      // second step: intermediate q (x[0]) -> s, input bit s[0]
+      for (x = 0; x < 2; x = x + 1) begin : step_b
+        wire [M-1:0]   q = (s >> 1) | (x << (M - 1));
+        wire [1:0]     exp_q;
+        wire [2*U-1:0] r;
+        wire [RW-1:0]  h;
+
+        expected_bits #(.K(K), .G0_OCT(G0_OCT), .G1_OCT(G1_OCT)) eb (
+            .pred (q), .b ((s % 2) == 1), .expected (exp_q)
+        );
+
+        if (PUNCT) begin : g_erase
+          erase_fill #(.U(U)) ef (.a (rx_sym1), .b (exp_q), .c (r));
+        end else begin : g_plain
+          assign r = rx_sym1;
+        end
+        if (SOFT) begin : g_soft
+          soft_bm #(.Q(SOFT)) hq (.a (r), .b (exp_q), .c (h));
+        end else begin : g_hard
+          ham2 hq (.a (r), .b (exp_q), .c (h));
+        end
+        assign bm_b[x*Wb +: Wb] = half ? {Wb{1'b0}} : h[Wb-1:0];
+      end
+
+      // first step: predecessor p (x) -> q, input bit s[1]
+      for (x = 0; x < 4; x = x + 1) begin : step_a
+        wire [M-1:0]   p = (s >> 2) | (x << (M - 2));
+        wire [1:0]     exp_p;
+        wire [2*U-1:0] r;
+        wire [RW-1:0]  h;
+
+        expected_bits #(.K(K), .G0_OCT(G0_OCT), .G1_OCT(G1_OCT)) eb (
+            .pred (p), .b (((s >> 1) % 2) == 1), .expected (exp_p)
+        );
+
+        if (PUNCT) begin : g_erase
+          erase_fill #(.U(U)) ef (.a (rx_sym0), .b (exp_p), .c (r));
+        end else begin : g_plain
+          assign r = rx_sym0;
+        end
+        if (SOFT) begin : g_soft
+          soft_bm #(.Q(SOFT)) hp (.a (r), .b (exp_p), .c (h));
+        end else begin : g_hard
+          ham2 hp (.a (r), .b (exp_p), .c (h));
+        end
+        assign bm_a[x*Wb +: Wb] = h[Wb-1:0];
+
+        assign pm_x[x*Wm +: Wm] = pm_q[((s >> 2) | (x << (M - 2)))*Wm +: Wm];
+      end
+
+      acs4_core #(.Wm(Wm), .Wb(Wb), .MODULO(MODULO)) acs (
+          .pm     (pm_x),
+          .bm_a   (bm_a),
+          .bm_b   (bm_b),
+          .pm_out  (pm4[s*Wm +: Wm]),
+          .dec     (dec4[2*s +: 2]),
+          .pm_mid  (mid_pm[2*s*Wm +: 2*Wm]),
+          .dec_mid (mid_dec[2*s +: 2])
+      );
+
+      // half: intermediate state s is x[0] = s[M-1] of state (s << 1) mod S
+      localparam H = ((s << 1) % S) * 2 + (s >> (M - 1));
+
+      assign pm_out[s*Wm +: Wm] = half ? mid_pm[H*Wm +: Wm] : pm4[s*Wm +: Wm];
+      assign dec[2*s +: 2]      = half ? {1'b0, mid_dec[H]} : dec4[2*s +: 2];
+    end
+  endgenerate
+
+endmodule
+
+`default_nettype wire
@@ -1,6 +1,7 @@
 module acs_core #(
     parameter Wm = 8,
-    parameter Wb = 2
+    parameter Wb = 2,
+    parameter MODULO = 0        // wrapping metrics, see pm_lt
 ) (
     input  wire [Wm-1:0] pm0,
     input  wire [Wm-1:0] pm1,
@@ -16,7 +17,12 @@ wire [Wm-1:0] metric1;
 assign metric0 = pm0 + {{(Wm-Wb){1'b0}}, bm0};
 assign metric1 = pm1 + {{(Wm-Wb){1'b0}}, bm1};
 
-assign surv    = (metric1 < metric0);
+pm_lt #(.Wm(Wm), .MODULO(MODULO)) cmp (
+    .a  (metric1),
+    .b  (metric0),
+    .lt (surv)
+);
+
 assign pm_out  = surv ? metric1 : metric0;
 
 endmodule
@@ -0,0 +1,171 @@
+//==============================================================================
+// acs_pipe: Pipelined one-state-per-cycle ACS with its own metric banks
+//==============================================================================
+// Drop-in for the serial acs_core + pm_bank sweep, split into three register
+// stages so no path runs from the metric array back into it:
+//
+//   R  (issue)  read pm[p0], pm[p1]; expected_bits + branch_metric  -> regs
+//   A           acs_core on the registered metrics / branch metrics -> out_*
+//   W           out_pm written to bank[out_bank][out_idx]
+//
+// State s = in_idx of the current step reads p0 = s >> 1, p1 = p0 + S/2,
+// so issue is a plain sweep s = 0 .. S-1 per trellis step, back to back:
+// rd_sel flips after state S-1 is issued. Each entry carries the bank it
+// writes, so the last states of step t still land in the bank step t + 1 is
+// already reading. State i of step t is issued in cycle c + i and written
+// in cycle c + i + 2; step t + 1 first reads it when issuing state 2i mod S,
+// in cycle c + S + (2i mod S). That is never earlier, and only the same
+// cycle for S = 4, i = 2: the read then takes out_pm from the write port
+// instead of the array. K >= 3.
+//
+// out_valid / out_idx / out_pm / out_surv are the W stage: the new metric
+// and decision of state out_idx, two cycles after its issue. pend is high
+// while an issued state has not reached them yet.
+//==============================================================================
+
+`default_nettype none
+
+module acs_pipe #(
+    parameter K        = 5,
+    parameter G0_OCT   = 'o23,
+    parameter G1_OCT   = 'o35,
+    parameter Wm       = 8,
+    parameter Wb       = 2,
+    parameter MODULO   = 0,         // wrapping metrics, see pm_lt
+    parameter SOFT     = 0,         // soft symbols, see branch_metric
+    parameter PUNCT    = 0,         // depunctured symbols, see branch_metric
+    parameter M        = K - 1,
+    parameter S        = 1 << M,
+    parameter SW       = (SOFT ? 2 * SOFT : 2) + (PUNCT ? 2 : 0)
+) (
+    input  wire          clk,
+    input  wire          rst,
+    input  wire          init_frame,
+    input  wire          init_flat,     // with init_frame: all start metrics 0
+    input  wire          in_valid,
+    input  wire [M-1:0]  in_idx,
+    input  wire [SW-1:0] rx_sym,
+
+    output reg           out_valid,
+    output reg  [M-1:0]  out_idx,
+    output reg  [Wm-1:0] out_pm,
+    output reg           out_surv,
+    output wire          pend
+);
+
+  // Start metric of states other than 0, as pm_bank
+  localparam [Wm-1:0] PM_INF = MODULO ? {2'b01, {(Wm-2){1'b0}}} : {1'b0, {(Wm-1){1'b1}}};
+
+  reg [Wm-1:0] bank0 [0:S-1];
+  reg [Wm-1:0] bank1 [0:S-1];
+  reg          rd_sel;            // bank the issuing step reads
+  reg          out_bank;          // bank out_pm is written to
+  integer i;
+
+  // ---------------------------------------------------------------------------
+  // R stage
+  // ---------------------------------------------------------------------------
+  wire [M-1:0] p0 = in_idx >> 1;
+  wire [M-1:0] p1 = (in_idx >> 1) | (1 << (M - 1));
+
+  wire [1:0]    exp0, exp1;
+  wire [Wb-1:0] bm0, bm1;
+
+  expected_bits #(.K(K), .G0_OCT(G0_OCT), .G1_OCT(G1_OCT)) eb0 (
+      .pred (p0), .b (in_idx[0]), .expected (exp0)
+  );
+  expected_bits #(.K(K), .G0_OCT(G0_OCT), .G1_OCT(G1_OCT)) eb1 (
+      .pred (p1), .b (in_idx[0]), .expected (exp1)
+  );
+
+  branch_metric #(.Wb(Wb), .SOFT(SOFT), .PUNCT(PUNCT)) bm_inst (
+      .rx_sym   (rx_sym),
+      .exp_sym0 (exp0),
+      .exp_sym1 (exp1),
+      .bm0      (bm0),
+      .bm1      (bm1)
+  );
+
+  // Write-port forwarding: the entry being written this cycle
+  wire          fwd  = out_valid && (out_bank == rd_sel);
+  wire [Wm-1:0] rd0  = (fwd && out_idx == p0) ? out_pm : rd_sel ? bank1[p0] : bank0[p0];
+  wire [Wm-1:0] rd1  = (fwd && out_idx == p1) ? out_pm : rd_sel ? bank1[p1] : bank0[p1];
+
+  reg           a_valid;
+  reg  [M-1:0]  a_idx;
+  reg           a_bank;
+  reg  [Wm-1:0] a_pm0, a_pm1;
+  reg  [Wb-1:0] a_bm0, a_bm1;
+
+  always @(posedge clk) begin
+    if (rst) begin
+      a_valid <= 0;
+      rd_sel  <= 0;
+    end else if (init_frame) begin
+      a_valid <= 0;
+      rd_sel  <= 0;
+    end else begin
+      a_valid <= in_valid;
+      if (in_valid && in_idx == S - 1)
+        rd_sel <= ~rd_sel;
+    end
+    a_idx  <= in_idx;
+    a_bank <= ~rd_sel;
+    a_pm0  <= rd0;
+    a_pm1  <= rd1;
+    a_bm0  <= bm0;
+    a_bm1  <= bm1;
+  end
+
+  // ---------------------------------------------------------------------------
+  // A stage
+  // ---------------------------------------------------------------------------
+  wire [Wm-1:0] acs_pm;
+  wire          acs_surv;
+
+  acs_core #(.Wm(Wm), .Wb(Wb), .MODULO(MODULO)) acs_inst (
+      .pm0    (a_pm0),
+      .pm1    (a_pm1),
+      .bm0    (a_bm0),
+      .bm1    (a_bm1),
+      .pm_out (acs_pm),
+      .surv   (acs_surv)
+  );
+
+  always @(posedge clk) begin
+    if (rst || init_frame)
+      out_valid <= 0;
+    else
+      out_valid <= a_valid;
+    out_idx  <= a_idx;
+    out_bank <= a_bank;
+    out_pm   <= acs_pm;
+    out_surv <= acs_surv;
+  end
+
+  assign pend = a_valid;
+
+  // ---------------------------------------------------------------------------
+  // W stage: bank 0 holds the start metrics, the first step reads it
+  // ---------------------------------------------------------------------------
+  always @(posedge clk) begin
+    if (rst) begin
+      for (i = 0; i < S; i = i + 1) begin
+        bank0[i] <= {Wm{1'b0}};
+        bank1[i] <= {Wm{1'b0}};
+      end
+    end else if (init_frame) begin
+      bank0[0] <= {Wm{1'b0}};
+      for (i = 1; i < S; i = i + 1)
+        bank0[i] <= init_flat ? {Wm{1'b0}} : PM_INF;
+    end else if (out_valid) begin
+      if (out_bank)
+        bank1[out_idx] <= out_pm;
+      else
+        bank0[out_idx] <= out_pm;
+    end
+  end
+
+endmodule
+
+`default_nettype wire
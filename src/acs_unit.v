@@ -0,0 +1,140 @@
+//==============================================================================
+// acs_unit: P radix-2 butterflies per cycle over a row-banked PM store
+//==============================================================================
+// Butterfly j (0 <= j < S/2) owns the predecessor pair p0 = j, p1 = j + S/2
+// and produces both successors that share it:
+//
+//   s = 2j + b,  b in {0,1}:  pm'[s] = min(pm[p0] + bm(p0,b), pm[p1] + bm(p1,b))
+//
+// Each butterfly is two copies of the serial datapath (expected_bits x2,
+// branch_metric, acs_core) so the decisions match project.v's one-state-per-
+// cycle mode bit for bit, ties included.
+//
+// Group g covers butterflies g*P .. g*P+P-1, so a trellis step is
+// GROUPS = S/(2P) cycles. pm_out / surv are combinational for group rd_grp;
+// the caller registers them and writes them back as row wr_row (= the group
+// that produced them) of the current bank, exactly like pm_bank's serial
+// write port.
+//
+// P = S/2 (GROUPS = 1) is the fully parallel trellis: the metrics live in one
+// S*Wm register instead of two banks, swap_banks is ignored and wr_en loads
+// all S new metrics at once, so the caller can feed pm_out straight back and
+// complete a trellis step every cycle.
+//==============================================================================
+
+`default_nettype none
+
+module acs_unit #(
+    parameter K        = 5,
+    parameter G0_OCT   = 'o23,
+    parameter G1_OCT   = 'o35,
+    parameter Wm       = 8,
+    parameter Wb       = 2,
+    parameter MODULO   = 0,         // wrapping metrics, see pm_lt
+    parameter SOFT     = 0,         // soft symbols, see branch_metric
+    parameter PUNCT    = 0,         // depunctured symbols, see branch_metric
+    parameter P        = 1,
+    parameter M        = K - 1,
+    parameter S        = 1 << M,
+    parameter GROUPS   = S / (2 * P),
+    parameter GB       = (GROUPS > 1) ? $clog2(GROUPS) : 1,
+    parameter SW       = (SOFT ? 2 * SOFT : 2) + (PUNCT ? 2 : 0)
+) (
+    input  wire                clk,
+    input  wire                rst,
+    input  wire                init_frame,
+    input  wire                init_flat,   // with init_frame: all metrics 0
+    input  wire                swap_banks,
+    input  wire [GB-1:0]       rd_grp,
+    input  wire [SW-1:0]       rx_sym,
+    input  wire                wr_en,
+    input  wire [GB-1:0]       wr_row,
+    input  wire [2*P*Wm-1:0]   wr_pm,
+
+    output wire [2*P*Wm-1:0]   pm_out,      // successors 2*g*P .. 2*g*P+2P-1
+    output wire [2*P-1:0]      surv,
+    output wire                prev_A
+);
+
+  wire [P*Wm-1:0] pm_lo, pm_hi;
+
+  genvar i, b;
+  generate
+    if (GROUPS == 1) begin : g_pm_regs
+      // state s at pm_q[s*Wm +: Wm]; predecessors j and j+S/2 are the halves
+      localparam [Wm-1:0]     PM_INF  = MODULO ? {2'b01, {(Wm-2){1'b0}}}
+                                               : {1'b0, {(Wm-1){1'b1}}};
+      localparam [2*P*Wm-1:0] PM_INIT = {{(2*P-1){PM_INF}}, {Wm{1'b0}}};
+
+      reg [2*P*Wm-1:0] pm_q;
+
+      always @(posedge clk) begin
+        if (rst)
+          pm_q <= {(2*P*Wm){1'b0}};
+        else if (init_frame)
+          pm_q <= init_flat ? {(2*P*Wm){1'b0}} : PM_INIT;
+        else if (wr_en)
+          pm_q <= wr_pm;
+      end
+
+      assign pm_lo  = pm_q[P*Wm-1:0];
+      assign pm_hi  = pm_q[2*P*Wm-1 -: P*Wm];
+      assign prev_A = 1'b1;
+
+      wire _unused = &{swap_banks, wr_row, 1'b0};
+    end else begin : g_pm_banks
+      pm_bank_wide #(.K(K), .Wm(Wm), .MODULO(MODULO), .P(P)) pm_inst (
+          .clk        (clk),
+          .rst        (rst),
+          .init_frame (init_frame),
+          .init_flat  (init_flat),
+          .rd_grp     (rd_grp),
+          .wr_en      (wr_en),
+          .wr_row     (wr_row),
+          .wr_pm      (wr_pm),
+          .swap_banks (swap_banks),
+          .rd_lo      (pm_lo),
+          .rd_hi      (pm_hi),
+          .prev_A     (prev_A)
+      );
+    end
+
+    for (i = 0; i < P; i = i + 1) begin : bfly
+      wire [M-1:0] j  = rd_grp * P + i;
+      wire [M-1:0] p0 = j;
+      wire [M-1:0] p1 = j | (1 << (M - 1));
+
+      for (b = 0; b < 2; b = b + 1) begin : succ
+        wire [1:0]    exp0, exp1;
+        wire [Wb-1:0] bm0, bm1;
+
+        expected_bits #(.K(K), .G0_OCT(G0_OCT), .G1_OCT(G1_OCT)) eb0 (
+            .pred (p0), .b (b == 1), .expected (exp0)
+        );
+        expected_bits #(.K(K), .G0_OCT(G0_OCT), .G1_OCT(G1_OCT)) eb1 (
+            .pred (p1), .b (b == 1), .expected (exp1)
+        );
+
+        branch_metric #(.Wb(Wb), .SOFT(SOFT), .PUNCT(PUNCT)) bm_inst (
+            .rx_sym   (rx_sym),
+            .exp_sym0 (exp0),
+            .exp_sym1 (exp1),
+            .bm0      (bm0),
+            .bm1      (bm1)
+        );
+
+        acs_core #(.Wm(Wm), .Wb(Wb), .MODULO(MODULO)) acs_inst (
+            .pm0    (pm_lo[i*Wm +: Wm]),
+            .pm1    (pm_hi[i*Wm +: Wm]),
+            .bm0    (bm0),
+            .bm1    (bm1),
+            .pm_out (pm_out[(2*i+b)*Wm +: Wm]),
+            .surv   (surv[2*i+b])
+        );
+      end
+    end
+  endgenerate
+
+endmodule
+
+`default_nettype wire
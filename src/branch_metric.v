@@ -1,29 +1,72 @@
 `default_nettype none
 
 module branch_metric #(
-    parameter Wb = 2
+    parameter Wb   = 2,
+    parameter SOFT = 0,                 // 0: hard symbols, Q: two Q-bit samples (soft_bm)
+    parameter PUNCT = 0,                // 1, 2: depunctured symbols with erase bits (erase_fill)
+    parameter SW   = (SOFT ? 2 * SOFT : 2) + (PUNCT ? 2 : 0)
 ) (
-    input  wire [1:0] rx_sym,
+    input  wire [SW-1:0] rx_sym,
     input  wire [1:0] exp_sym0,
     input  wire [1:0] exp_sym1,
     output wire [Wb-1:0] bm0,
     output wire [Wb-1:0] bm1
 );
 
-    wire [1:0] bm0_raw;
-    wire [1:0] bm1_raw;
+    localparam RW = SOFT ? SOFT + 1 : 2;
+    localparam U  = SOFT ? SOFT : 1;
 
-    ham2 ham0 (
-        .a(rx_sym),
-        .b(exp_sym0),
-        .c(bm0_raw)
-    );
+    wire [RW-1:0] bm0_raw;
+    wire [RW-1:0] bm1_raw;
 
-    ham2 ham1 (
-        .a(rx_sym),
-        .b(exp_sym1),
-        .c(bm1_raw)
-    );
+    // Received symbol as scored against each branch
+    wire [2*U-1:0] rx0;
+    wire [2*U-1:0] rx1;
+
+    generate
+        if (PUNCT) begin : g_erase
+            erase_fill #(.U(U)) ef0 (
+                .a(rx_sym),
+                .b(exp_sym0),
+                .c(rx0)
+            );
+
+            erase_fill #(.U(U)) ef1 (
+                .a(rx_sym),
+                .b(exp_sym1),
+                .c(rx1)
+            );
+        end else begin : g_plain
+            assign rx0 = rx_sym;
+            assign rx1 = rx_sym;
+        end
+
+        if (SOFT) begin : g_soft
+            soft_bm #(.Q(SOFT)) sbm0 (
+                .a(rx0),
+                .b(exp_sym0),
+                .c(bm0_raw)
+            );
+
+            soft_bm #(.Q(SOFT)) sbm1 (
+                .a(rx1),
+                .b(exp_sym1),
+                .c(bm1_raw)
+            );
+        end else begin : g_hard
+            ham2 ham0 (
+                .a(rx0),
+                .b(exp_sym0),
+                .c(bm0_raw)
+            );
+
+            ham2 ham1 (
+                .a(rx1),
+                .b(exp_sym1),
+                .c(bm1_raw)
+            );
+        end
+    endgenerate
 
     assign bm0 = bm0_raw[Wb-1:0];
     assign bm1 = bm1_raw[Wb-1:0];
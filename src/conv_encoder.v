@@ -10,12 +10,16 @@
 //   - Tail-termination: drive K-1 zeros after the frame.
 //   - Tail-biting: assert seed_load with seed = last M info bits before starting.
 //   - out_valid is 1-cycle aligned to in_valid; one symbol per in_valid=1 cycle.
+//   - PUNCT = 1 (rate 2/3) / 2 (rate 3/4): out_keep marks the bits of out_sym
+//     the pattern transmits (c-tests/punct.h); the pattern restarts on rst
+//     and seed_load. Drop the other bits before the channel.
 
 module conv_encoder_1_2 #(
   parameter K  = 4,                      // constraint length (>=2)
   parameter M  = (K-1),
   parameter G0_OCT = 8'o17,              // e.g., K=4: (17,13)_8 is classic
-  parameter G1_OCT = 8'o13
+  parameter G1_OCT = 8'o13,
+  parameter PUNCT  = 0                   // 0: rate 1/2, 1: 2/3, 2: 3/4
 )(
   input  wire        clk,
   input  wire        rst,                // synchronous reset
@@ -30,7 +34,8 @@ module conv_encoder_1_2 #(
 
   // Streaming output: one coded symbol per in_valid=1 cycle
   output reg         out_valid,
-  output reg  [1:0]  out_sym             // {c0, c1} with c0 from G0, c1 from G1
+  output reg  [1:0]  out_sym,            // {c0, c1} with c0 from G0, c1 from G1
+  output reg  [1:0]  out_keep            // {c0, c1} sent, 2'b11 for PUNCT = 0
 );
 
   // ------------------------------
@@ -80,6 +85,16 @@ module conv_encoder_1_2 #(
   assign c0 = ^(reg_vec & G0_MASK);           // reduction XOR → parity
   assign c1 = ^(reg_vec & G1_MASK);
 
+  // ------------------------------
+  // Puncturing: symbol phase within the pattern period
+  //   PUNCT = 1: 11 10      PUNCT = 2: 11 01 10
+  // ------------------------------
+  reg  [1:0] phase;
+  wire [1:0] keep = (PUNCT == 1) ? ((phase == 2'd0) ? 2'b11 : 2'b10) :
+                    (PUNCT == 2) ? ((phase == 2'd0) ? 2'b11 :
+                                    (phase == 2'd1) ? 2'b01 : 2'b10) : 2'b11;
+  wire [1:0] phase_last = (PUNCT == 2) ? 2'd2 : (PUNCT == 1) ? 2'd1 : 2'd0;
+
   // ------------------------------
   // Sequential update & output staging
   // out_valid mirrors in_valid (1-cycle timing alignment with outputs)
@@ -88,22 +103,27 @@ module conv_encoder_1_2 #(
   always @(posedge clk) begin
     if (rst) begin
       state     <= {M{1'b0}};
+      phase     <= 2'd0;
       out_valid <= 1'b0;
       out_sym   <= 2'b00;
+      out_keep  <= 2'b11;
     end else begin
       // Optional reseed (tail-biting / frame init)
       if (seed_load) begin
         state <= seed_value;
+        phase <= 2'd0;
       end else if (in_valid) begin
         // Update state: LSB insertion to match golden model
         // next = (state << 1) | in_bit
         state <= {state[M-2:0], in_bit};
+        phase <= (phase == phase_last) ? 2'd0 : phase + 2'd1;
       end
 
       // Emit symbol when input is valid
       out_valid <= in_valid;
       if (in_valid) begin
-        out_sym <= {c0, c1};               // pack as {c0,c1}
+        out_sym  <= {c0, c1};              // pack as {c0,c1}
+        out_keep <= keep;
       end
     end
   end
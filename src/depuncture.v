@@ -0,0 +1,67 @@
+//==============================================================================
+// depuncture: Rebuild the symbols of one punctured input byte
+//==============================================================================
+// The host sends only the kept bits of each symbol (c-tests/punct.h), c1
+// before c0, as units: hard bits, 8 per byte, or with SOFT = Q samples, 2
+// per byte, first unit in the LSBs. off counts units into the pattern
+// period; unit 0 of a period is the c1 of a symbol whose c0 is still to
+// come (held), every other unit completes a symbol:
+//
+//   PUNCT  rate  off 1        off 2         off 3
+//     1    2/3   {c0, held}   {c0, -}
+//     2    3/4   {c0, held}   {-, c1}       {c0, -}
+//
+// Each symbol is {erase, c0, c1} with erase[1] / erase[0] marking a
+// punctured c0 / c1 (sample 0, see erase_fill). syms holds the n symbols the
+// byte completes, in order; off_nx / held_nx carry over to the next byte.
+//==============================================================================
+
+`default_nettype none
+
+module depuncture #(
+    parameter PUNCT = 1,                // 1: rate 2/3, 2: rate 3/4
+    parameter SOFT  = 0,                // 0: hard bits, Q: Q-bit samples
+    parameter U     = SOFT ? SOFT : 1,  // unit width
+    parameter C     = SOFT ? 2 : 8,     // units per byte
+    parameter EW    = 2 * U + 2,        // symbol width, with the erase bits
+    parameter N     = SOFT ? 2 : 6      // most symbols one byte completes
+) (
+    input  wire [7:0]      in_byte,
+    input  wire [1:0]      off,
+    input  wire [U-1:0]    held,
+
+    output reg  [N*EW-1:0] syms,
+    output reg  [3:0]      n,
+    output reg  [1:0]      off_nx,
+    output reg  [U-1:0]    held_nx
+);
+
+  localparam KEPT = (PUNCT == 2) ? 4 : 3;   // units per period
+
+  localparam [U-1:0] Z = {U{1'b0}};
+
+  reg [U-1:0] v;
+  integer u;
+
+  always @* begin
+    syms    = {(N*EW){1'b0}};
+    n       = 4'd0;
+    off_nx  = off;
+    held_nx = held;
+    for (u = 0; u < C; u = u + 1) begin
+      v = in_byte[u*U +: U];
+      case (off_nx)
+        2'd0: held_nx = v;
+        2'd1: syms[n*EW +: EW] = {2'b00, v, held_nx};
+        2'd2: syms[n*EW +: EW] = (PUNCT == 2) ? {2'b10, Z, v} : {2'b01, v, Z};
+        default: syms[n*EW +: EW] = {2'b01, v, Z};
+      endcase
+      if (off_nx != 2'd0)
+        n = n + 4'd1;
+      off_nx = (off_nx == KEPT - 1) ? 2'd0 : off_nx + 2'd1;
+    end
+  end
+
+endmodule
+
+`default_nettype wire
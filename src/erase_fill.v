@@ -0,0 +1,24 @@
+//==============================================================================
+// erase_fill: Punctured samples of a depunctured symbol take the expected bit
+//==============================================================================
+// a is a depuncture symbol {erase[1:0], c0, c1} of two U-bit samples. An
+// erased sample is replaced by b's bit at full confidence (all zeros or all
+// ones), so ham2 / soft_bm score it 0 against b whatever was stored.
+//==============================================================================
+
+`default_nettype none
+
+module erase_fill #(
+    parameter U = 1
+) (
+    input  wire [2*U+1:0] a,
+    input  wire [1:0]     b,
+    output wire [2*U-1:0] c
+);
+
+    assign c = {a[2*U+1] ? {U{b[1]}} : a[2*U-1:U],
+                a[2*U]   ? {U{b[0]}} : a[U-1:0]};
+
+endmodule
+
+`default_nettype wire
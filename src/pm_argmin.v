@@ -0,0 +1,48 @@
+//==============================================================================
+// pm_argmin: Smallest of N path metrics and its index
+//==============================================================================
+// Binary comparator tree, log2(N) levels, N a power of two. Node i of the
+// heap has children 2i+1 / 2i+2 and leaf j is node N-1+j, so the left child
+// always covers the lower indices; it wins unless the right one is strictly
+// smaller. Ties therefore go to the lowest index, like the C model's argmin.
+// MODULO = 1 compares wrapping metrics (pm_lt).
+//==============================================================================
+
+`default_nettype none
+
+module pm_argmin #(
+    parameter N  = 16,
+    parameter Wm = 8,
+    parameter MODULO = 0,
+    parameter IW = (N > 1) ? $clog2(N) : 1
+) (
+    input  wire [N*Wm-1:0] pm,          // metric j at pm[j*Wm +: Wm]
+    output wire [Wm-1:0]   min_pm,
+    output wire [IW-1:0]   min_idx
+);
+
+    wire [Wm-1:0] node_pm  [0:2*N-2];
+    wire [IW-1:0] node_idx [0:2*N-2];
+
+    genvar i;
+    generate
+        for (i = 0; i < N; i = i + 1) begin : g_leaf
+            assign node_pm[N-1+i]  = pm[i*Wm +: Wm];
+            assign node_idx[N-1+i] = i;
+        end
+        for (i = 0; i < N - 1; i = i + 1) begin : g_node
+            wire take_r;
+            pm_lt #(.Wm(Wm), .MODULO(MODULO)) lt_inst (
+                .a  (node_pm[2*i+2]),
+                .b  (node_pm[2*i+1]),
+                .lt (take_r)
+            );
+            assign node_pm[i]  = take_r ? node_pm[2*i+2]  : node_pm[2*i+1];
+            assign node_idx[i] = take_r ? node_idx[2*i+2] : node_idx[2*i+1];
+        end
+    endgenerate
+
+    assign min_pm  = node_pm[0];
+    assign min_idx = node_idx[0];
+
+endmodule
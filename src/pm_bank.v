@@ -2,11 +2,13 @@ module pm_bank #(
     parameter K = 5,
     parameter M = K - 1,
     parameter S = 1 << M,
-    parameter Wm = 8
+    parameter Wm = 8,
+    parameter MODULO = 0
 ) (
     input wire clk,
     input wire rst,
     input wire init_frame,
+    input wire init_flat,           // with init_frame: every state starts at 0
     input wire [M-1:0] rd_idx0,
     input wire [M-1:0] rd_idx1,
     input wire wr_en,
@@ -20,6 +22,14 @@ module pm_bank #(
     output reg prev_A
 );
 
+  // Start metric of states other than 0: never wins before state 0's paths
+  // reach it, and with MODULO stays within pm_lt's half range
+  localparam [Wm-1:0] PM_INF = MODULO ? {2'b01, {(Wm-2){1'b0}}} : {1'b0, {(Wm-1){1'b1}}};
+
+  // Start metric of the other states: PM_INF, or 0 for a tail-biting frame,
+  // which may start in any state
+  wire [Wm-1:0] pm_start = init_flat ? {Wm{1'b0}} : PM_INF;
+
   reg [Wm-1:0] bank0 [0:S-1];
   reg [Wm-1:0] bank1 [0:S-1];
   integer i;
@@ -52,11 +62,11 @@ module pm_bank #(
         if (prev_A) begin
           bank1[0] <= {Wm{1'b0}};
           for (i = 1; i < S; i = i + 1)
-            bank1[i] <= {1'b0, {(Wm-1){1'b1}}};
+            bank1[i] <= pm_start;
         end else begin
           bank0[0] <= {Wm{1'b0}};
           for (i = 1; i < S; i = i + 1)
-            bank0[i] <= {1'b0, {(Wm-1){1'b1}}};
+            bank0[i] <= pm_start;
         end
       end
 
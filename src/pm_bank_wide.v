@@ -0,0 +1,103 @@
+//==============================================================================
+// pm_bank_wide: Row-organised ping-pong path metric storage for acs_unit
+//==============================================================================
+// Same protocol as pm_bank (init_frame fills the current bank, all zero with
+// init_flat, swap_banks
+// flips prev/current, reads anticipate a pending swap), but each row holds
+// 2P consecutive state metrics so P butterflies can be fed per cycle:
+//
+//   row r = states r*2P .. r*2P+2P-1     (ROWS = S/(2P) rows per bank)
+//
+// Butterfly group g (butterflies j = g*P .. g*P+P-1) needs predecessors
+// j and j+S/2, i.e. P metrics starting at g*P and P metrics starting at
+// S/2 + g*P. Each is one half of a row, so two row reads per cycle cover a
+// group, and the group's 2P successors 2j, 2j+1 are exactly row g.
+//==============================================================================
+
+`default_nettype none
+
+module pm_bank_wide #(
+    parameter K  = 5,
+    parameter M  = K - 1,
+    parameter S  = 1 << M,
+    parameter Wm = 8,
+    parameter MODULO = 0,
+    parameter P  = 1,                       // butterflies per cycle, 1..S/2
+    parameter ROWS = S / (2 * P),
+    parameter RB = (ROWS > 1) ? $clog2(ROWS) : 1
+) (
+    input  wire                clk,
+    input  wire                rst,
+    input  wire                init_frame,
+    input  wire                init_flat,
+    input  wire [RB-1:0]       rd_grp,       // butterfly group to read
+    input  wire                wr_en,
+    input  wire [RB-1:0]       wr_row,
+    input  wire [2*P*Wm-1:0]   wr_pm,
+    input  wire                swap_banks,
+
+    output wire [P*Wm-1:0]     rd_lo,        // metrics of states g*P ..
+    output wire [P*Wm-1:0]     rd_hi,        // metrics of states S/2 + g*P ..
+    output reg                 prev_A
+);
+
+  localparam ROW_W = 2 * P * Wm;
+
+  reg [ROW_W-1:0] bank0 [0:ROWS-1];
+  reg [ROW_W-1:0] bank1 [0:ROWS-1];
+  integer i;
+
+  // Row / half addressing of the two predecessor blocks (see header)
+  wire [RB:0] lo_sel = {1'b0, rd_grp};
+  wire [RB:0] hi_sel = ROWS + rd_grp;
+  wire [RB-1:0] lo_row = lo_sel >> 1;
+  wire [RB-1:0] hi_row = hi_sel >> 1;
+
+  wire read_from_A = swap_banks ? ~prev_A : prev_A;
+
+  wire [ROW_W-1:0] lo_data = read_from_A ? bank0[lo_row] : bank1[lo_row];
+  wire [ROW_W-1:0] hi_data = read_from_A ? bank0[hi_row] : bank1[hi_row];
+
+  assign rd_lo = lo_sel[0] ? lo_data[ROW_W-1 -: P*Wm] : lo_data[P*Wm-1:0];
+  assign rd_hi = hi_sel[0] ? hi_data[ROW_W-1 -: P*Wm] : hi_data[P*Wm-1:0];
+
+  // init value: state 0 = 0, every other state = max positive metric
+  // (2^(Wm-2) with MODULO, inside pm_lt's half range)
+  localparam [Wm-1:0] PM_ZERO = {Wm{1'b0}};
+  localparam [Wm-1:0] PM_INF  = MODULO ? {2'b01, {(Wm-2){1'b0}}} : {1'b0, {(Wm-1){1'b1}}};
+  localparam [ROW_W-1:0] ROW_INF  = {(2*P){PM_INF}};
+  localparam [ROW_W-1:0] ROW0_INIT = {{(2*P-1){PM_INF}}, PM_ZERO};
+
+  wire [ROW_W-1:0] row_inf  = init_flat ? {ROW_W{1'b0}} : ROW_INF;
+  wire [ROW_W-1:0] row0_init = init_flat ? {ROW_W{1'b0}} : ROW0_INIT;
+
+  always @(posedge clk) begin
+    if (rst) begin
+      for (i = 0; i < ROWS; i = i + 1) begin
+        bank0[i] <= {ROW_W{1'b0}};
+        bank1[i] <= {ROW_W{1'b0}};
+      end
+      prev_A <= 1'b1;
+    end else begin
+      if (init_frame) begin
+        for (i = 0; i < ROWS; i = i + 1) begin
+          if (prev_A) bank1[i] <= (i == 0) ? row0_init : row_inf;
+          else        bank0[i] <= (i == 0) ? row0_init : row_inf;
+        end
+      end
+
+      if (wr_en) begin
+        if (prev_A)
+          bank1[wr_row] <= wr_pm;
+        else
+          bank0[wr_row] <= wr_pm;
+      end
+
+      if (swap_banks)
+        prev_A <= ~prev_A;
+    end
+  end
+
+endmodule
+
+`default_nettype wire
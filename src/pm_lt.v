@@ -0,0 +1,25 @@
+//==============================================================================
+// pm_lt: Path-metric compare, a < b
+//==============================================================================
+// MODULO = 0 is a plain unsigned compare. MODULO = 1 treats the metrics as
+// wrapping Wm-bit counters: a < b iff (a - b) mod 2^Wm has its MSB set. That
+// is exact while the true difference stays below 2^(Wm-1), so the metrics
+// never need renormalising; project.v sizes Wm from the metric spread.
+//==============================================================================
+
+`default_nettype none
+
+module pm_lt #(
+    parameter Wm     = 8,
+    parameter MODULO = 0
+) (
+    input  wire [Wm-1:0] a,
+    input  wire [Wm-1:0] b,
+    output wire          lt
+);
+
+    wire [Wm-1:0] diff = a - b;
+
+    assign lt = MODULO ? diff[Wm-1] : (a < b);
+
+endmodule
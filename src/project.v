@@ -5,14 +5,179 @@
  *
  * UART byte interface:
  *   Input:  uio_in[7:0]  = 4 packed 2-bit symbols per byte
+ *                          (SOFT = Q: one symbol, uio_in[2Q-1:0];
+ *                          PUNCT: punctured bit / sample stream)
  *           ui_in[0]     = byte_valid
+ *           ui_in[1]     = trunc (with START: frame has no tail)
+ *           ui_in[2]     = tbite (with START: tail-biting frame)
  *           ui_in[3]     = start (begin decoding)
  *           ui_in[4]     = read_ack
+ *           ui_in[7:5]   = channel of byte_valid / start (NCTX > 1)
  *   Output: uio_out[7:0] = 8 decoded bits per byte
  *           uo_out[0]    = byte_in_ready
  *           uo_out[1]    = byte_out_valid
  *           uo_out[3]    = busy
  *           uo_out[4]    = done
+ *           uo_out[7:5]  = channel of the output byte (NCTX > 1), else
+ *                          IN_FIFO / OUT_FIFO flags (see below)
+ *
+ * ACS_PAR selects the trellis datapath:
+ *   0          one state per cycle (acs_core + pm_bank), NUM_STATES + 1
+ *              cycles per symbol, smallest area
+ *   P          P butterflies (2P states) per cycle (acs_unit + pm_bank_wide),
+ *              NUM_STATES/(2P) + 1 cycles per symbol; P = 1, 2, 4 .. NUM_STATES/4
+ *   NUM_STATES/2  fully parallel trellis: register path metrics, the whole
+ *              survivor row written directly, 1 cycle per symbol
+ *
+ * ACS_PIPE = 1 (ACS_PAR = 0, radix-2) runs the serial sweep through
+ * acs_pipe: registered metric reads and branch metrics, then the ACS, then
+ * the write, with write-port forwarding into the read. No path goes from
+ * the metric array through the adders back into it, and trellis steps
+ * follow each other without S_ACS_COMMIT: NUM_STATES cycles per symbol,
+ * plus two cycles per frame and one per window traceback to drain it.
+ *
+ * RADIX = 4 replaces the ACS_PAR datapath with a fully parallel radix-4
+ * trellis (acs4_unit): two symbols per cycle, 2-bit decisions per state and
+ * a two-step traceback. MAX_FRAME must be even. SOFT and PUNCT frames can
+ * still have an odd length: their last symbol gets a single radix-2 step
+ * (acs4_unit half) and its column is traced in one extra cycle, as with
+ * TB_PAIR.
+ *
+ * NBUF = 2 double-buffers the symbol and output buffers: receive, decode and
+ * output run concurrently, one frame each. START closes the frame being
+ * received and queues it for decode, the next frame's bytes can follow
+ * immediately, and decoded bytes appear whenever a frame finishes (frames
+ * chain without a START per frame_done). Input bytes are only taken while
+ * no output byte is pending (uio is shared; OUT_FIFO can give it up, see
+ * below), and a byte on the START cycle is dropped. DONE is high while
+ * nothing is queued, decoding or draining.
+ *
+ * NCTX = N (2..8) extends the ping-pong buffers to one symbol / output slot
+ * per channel, addressed by ui_in[7:5]: each channel receives and closes
+ * its own frames (BYTE_IN_READY is that of the channel on ui_in[7:5]),
+ * and the one ACS / survivor datapath decodes full slots in round-robin
+ * order, a frame at a time. Output bytes carry their channel on
+ * uo_out[7:5] and the drain also takes full slots round robin. A frame is
+ * decoded start to finish before the next, so the metric banks and the
+ * survivor memory are not replicated: a channel costs a slot of sym_buf
+ * and out_buf plus its counters. NBUF is ignored.
+ *
+ * IN_FIFO = D / OUT_FIFO = D (a power of two, 0 = off; NBUF = 2, NCTX = 1)
+ * put a D-entry sync_fifo between the pins and the ping-pong slots. Input
+ * bytes and START (with TRUNC / TBITE) are queued in order whenever the
+ * input FIFO has room, so BYTE_IN_READY no longer waits for a free slot,
+ * and the receive side takes one entry per cycle from the head once its
+ * slot is free. The last entry is kept for START: bytes are taken only
+ * while fewer than D - 1 entries are queued, so START, which has no ready
+ * of its own, always finds room (the only START that can meet a full
+ * FIFO follows another START and closes an empty frame, which is
+ * ignored). The drain moves decoded bytes into the output FIFO as fast as
+ * it has room, so a slot is released without waiting for READ_ACK, and
+ * READ_ACK pops the FIFO's head. uio stays shared, but the output FIFO
+ * gives it up on request: BYTE_VALID while BYTE_OUT_VALID is up (the
+ * host must not drive uio yet) releases the pins from the next cycle for
+ * as long as BYTE_VALID is held and the byte has room, so input is
+ * queued while output bytes wait in the FIFO. The next output byte also
+ * follows a READ_ACK a cycle later, as without the FIFO, so a host can
+ * send input between them. uo_out[5] / [6] are the input FIFO's
+ * almost-full / almost-empty flags, uo_out[7] the output FIFO's almost-full
+ * flag (a quarter of the depth from either end, 0 without the FIFO). DONE
+ * also waits for both FIFOs to empty.
+ *
+ * CUT_THROUGH = 1 (NBUF = 1 only) starts ACS_INIT on the first byte of a
+ * frame and runs trellis step t as soon as symbol t is in sym_buf, while the
+ * rest of the frame is still arriving; START only closes the frame. The
+ * host protocol is unchanged. After the last byte only the ACS steps the
+ * host has outpaced, the traceback and the first output byte remain.
+ *
+ * OUT_MODE (NBUF = 1 only) selects the drain:
+ *   0          one byte per READ_ACK, at least two cycles per byte
+ *   1          registered valid/ready: the READ_ACK edge loads the next byte
+ *              from a shift register, so holding READ_ACK drains one byte
+ *              per cycle
+ *   2          as 1, overlapped with the traceback: bytes go out last byte
+ *              first, each as soon as the traceback has written all of it,
+ *              so only byte 0 is left after S_TRACE
+ *
+ * BEST_SEARCH = 1 keeps a running minimum of the new path metrics during
+ * the last trellis step (pm_argmin over the states of each ACS cycle), so
+ * the traceback can start from the best end state. A frame closed with
+ * TRUNC set on the START cycle is decoded that way and delivers all
+ * frame_len bits; without TRUNC the frame is tail-terminated as before:
+ * traceback from state 0, frame_len - M bits. BEST_SEARCH = 0 (the default)
+ * ignores TRUNC. A SURV_DEPTH ring and TAIL_BITE need the best state and
+ * turn the search on by themselves.
+ *
+ * TAIL_BITE = W (1..3, 0 = off) decodes a frame closed with TBITE on the
+ * START cycle as tail-biting: the encoder started in the state of the
+ * frame's last M bits (conv_encoder seed_load), so no tail is sent and all
+ * frame_len bits are data. Every state starts at metric 0 and
+ * the ACS runs over the frame W times to warm the metrics up, then once
+ * more for the survivors. S_TRACE follows the best end state's path once
+ * round the frame without writing, which lands on the state the path
+ * started in, and traces back again from there. Each warm-up costs an ACS
+ * pass and two cycles, the extra circle a traceback. With CUT_THROUGH the
+ * first pass runs before START, from state 0 as usual. REG_EXCHANGE and a
+ * SURV_DEPTH ring ignore TBITE, and PM_MODULO = 0 metrics grow over all
+ * W + 1 passes. Frames shorter than about 5K symbols decode worse than with
+ * a tail (c-tests/viterbi_golden.c).
+ *
+ * SURV_DEPTH (a power of two, at least 8; 0 = MAX_FRAME) sizes the survivor
+ * memory independently of the frame. Once SURV_DEPTH steps are stored, the
+ * ACS pauses for a window traceback over the whole ring, from the best state
+ * of the newest step, which decides the oldest quarter and frees it; the
+ * final traceback only covers what is left. The
+ * other three quarters are the convergence depth, so a SURV_DEPTH of about
+ * 6K to 8K costs little against a whole-frame traceback. Each window costs
+ * SURV_DEPTH + 2 cycles (SURV_DEPTH / 2 + 2 with RADIX = 4).
+ *
+ * TB_PAIR = 1 (radix-2, no SURV_DEPTH ring) stores survivor columns in
+ * pairs: when column 2j+1 is written, each state s gets both decisions of
+ * its two-step path, {d(2j)[p], d(2j+1)[s]} with p its predecessor, so the
+ * survivor memory has the radix-4 layout and S_TRACE moves two steps per
+ * cycle, as with RADIX = 4. Column 2j waits in a row register; the last
+ * column of an odd frame is traced from there in one extra cycle. The
+ * traceback takes ceil(frame_len / 2) cycles instead of frame_len, for an
+ * S-bit row register and S 2:1 muxes.
+ *
+ * REG_EXCHANGE = 1 replaces survivor_mem and the traceback loop with a
+ * register-exchange unit (reg_exchange): every state carries its decoded
+ * path, so S_TRACE is a single cycle that copies the end state's path into
+ * the output buffer. The decode is identical; SURV_DEPTH is ignored.
+ *
+ * SOFT = Q (1..4, 0 = hard decision) takes soft-decision symbols: one per
+ * input byte, uio_in[2Q-1:Q] the Q-bit sample of the G0 bit and
+ * uio_in[Q-1:0] that of the G1 bit, 0 a confident 0 and 2^Q - 1 a
+ * confident 1 (Q = 3: uio_in[5:3], uio_in[2:0]). soft_bm scores each
+ * sample by its distance from the expected bit, so branch metrics run
+ * 0 .. 2(2^Q - 1) instead of 0 .. 2 and the path metrics widen to match.
+ * Q = 3 gains about 1.8 dB over hard decision on AWGN (K = 5, BER 1e-3)
+ * for a quarter of the symbols per byte. CONTINUOUS stays hard-decision.
+ *
+ * PUNCT = 1 (rate 2/3) or 2 (rate 3/4) takes a punctured code: the host
+ * sends only the kept bits of each symbol (c-tests/punct.h), 8 bits or 2
+ * soft samples per byte, and depuncture rebuilds up to 6 (2) symbols per
+ * byte into sym_buf with an erase bit per punctured position. erase_fill
+ * scores erased bits 0 on every branch, so the ACS is unchanged. A frame is
+ * the symbols completed by its bytes; zero padding in the last byte decodes
+ * as more zero bits after the tail. CONTINUOUS stays rate 1/2.
+ *
+ * PM_MODULO = 1 lets path metrics wrap: every compare (pm_lt) takes the
+ * sign of the Wm-bit difference, which is exact while metrics differ by less
+ * than 2^(Wm-1), so no normalisation is needed and frames of any length are
+ * safe. PM_WIDTH = 0 picks the smallest such width (6 bits for K = 5, 9 with
+ * SOFT = 3). With PM_MODULO = 0 (the default) compares are plain and
+ * PM_WIDTH = 0 sizes the metrics for the largest one a frame can reach:
+ * 8 bits (11 with SOFT) for MAX_FRAME = 32, more for longer frames or
+ * TAIL_BITE passes.
+ *
+ * CONTINUOUS = 1 drives the pins from viterbi_stream instead: an unbounded
+ * symbol stream decoded with traceback depth TB_DEPTH, output bytes as soon
+ * as 8 bits are decided, no START/DONE per frame. START restarts the stream
+ * from state 0, DONE stays low, and input bytes are only taken while no
+ * output byte is pending (uio is shared). TB_BLOCK = B decides B bits per
+ * traceback pass (TB_DEPTH + B - 1 steps every B symbols) instead of one
+ * bit per TB_DEPTH-step traceback, so the traceback keeps up with the ACS sweep.
  */
 
 `default_nettype none
@@ -22,7 +187,27 @@ module tt_um_ashvin_viterbi #(
     parameter G0_OCT    = 'o23,
     parameter G1_OCT    = 'o35,
     parameter MAX_FRAME = 32,
-    parameter PM_WIDTH  = 8
+    parameter SURV_DEPTH = 0,
+    parameter REG_EXCHANGE = 0,
+    parameter TB_PAIR   = 0,
+    parameter PM_WIDTH  = 0,
+    parameter PM_MODULO = 0,
+    parameter SOFT      = 0,
+    parameter PUNCT     = 0,
+    parameter ACS_PAR   = 0,
+    parameter ACS_PIPE  = 0,
+    parameter RADIX     = 2,
+    parameter NBUF      = 1,
+    parameter NCTX      = 1,
+    parameter IN_FIFO   = 0,
+    parameter OUT_FIFO  = 0,
+    parameter CUT_THROUGH = 0,
+    parameter OUT_MODE  = 0,
+    parameter BEST_SEARCH = 0,
+    parameter TAIL_BITE = 0,
+    parameter CONTINUOUS = 0,
+    parameter TB_DEPTH  = 32,
+    parameter TB_BLOCK  = 1
 ) (
     input  wire [7:0] ui_in,
     output wire [7:0] uo_out,
@@ -36,16 +221,70 @@ module tt_um_ashvin_viterbi #(
 
     localparam M          = K - 1;
     localparam NUM_STATES = 1 << M;
-    localparam Wb         = 2;
+    // Input symbols: SOFT = Q packs one symbol of two Q-bit samples per
+    // byte instead of four 2-bit hard ones; BM_MAX is the largest branch
+    // metric of one symbol (ham2 or soft_bm). PUNCT stores two erase bits
+    // with each symbol, and a byte completes up to SYM_PB of them
+    localparam SYM_W      = (SOFT ? 2 * SOFT : 2) + (PUNCT ? 2 : 0);
+    localparam SYM_PB     = PUNCT ? (SOFT ? 2 : 6) : SOFT ? 1 : 4;
+    localparam BYTE_W     = SYM_PB * SYM_W;
+    localparam SMP_W      = SOFT ? SOFT : 1;
+    localparam BM_MAX     = SOFT ? 2 * ((1 << SOFT) - 1) : 2;
+    localparam Wb         = SOFT ? SOFT + 1 : 2;
     localparam STATE_BITS = (M < 1) ? 1 : M;
-    localparam FRAME_BITS = 6;
+    localparam FRAME_BITS = ($clog2(MAX_FRAME + 1) < 6) ? 6 : $clog2(MAX_FRAME + 1);
+
+    // States evaluated per S_ACS cycle, and S_ACS cycles per trellis step
+    localparam SPC        = (ACS_PAR == 0) ? 1 : 2 * ACS_PAR;
+    localparam NUM_GROUPS = NUM_STATES / SPC;
+    // Fully parallel: S_ACS finishes a trellis step per cycle, no commit
+    localparam ACS_FULL   = (ACS_PAR != 0) && (NUM_GROUPS == 1);
+    // Radix-4: one S_ACS cycle and one traceback cycle per symbol pair
+    localparam R4         = (RADIX == 4);
+    // Pipelined serial ACS: S_ACS issues one state per cycle into acs_pipe,
+    // whose results land two cycles later
+    localparam PIPE       = (ACS_PIPE != 0) && (ACS_PAR == 0) && !R4;
+    // Ping-pong buffers: receive / decode / output each own one frame.
+    // Multi-channel (MC): one slot per channel, the same three sides
+    localparam MC         = (NCTX > 1);
+    localparam PP         = (NBUF == 2) || MC;
+    localparam NSLOT      = MC ? NCTX : NBUF;
+    localparam SLOT_W     = (NSLOT > 2) ? $clog2(NSLOT) : 1;
+    // Pin FIFOs in front of the ping-pong slots (one channel only: NCTX
+    // needs ui_in[7:5] / uo_out[7:5])
+    localparam IFIFO      = (IN_FIFO != 0) && PP && !MC;
+    localparam OFIFO      = (OUT_FIFO != 0) && PP && !MC;
+    // Cut-through receive: ACS overlaps the rest of the frame's bytes
+    localparam CT         = (CUT_THROUGH != 0) && !PP;
+    // Output drain: 1 = one byte per cycle, 2 = also overlapped with S_TRACE
+    localparam OUT_STREAM = (OUT_MODE != 0) && !PP;
+    localparam OUT_OVL    = (OUT_MODE == 2) && !PP;
+    // Path-metric width. Modulo metrics (pm_lt) need every compared
+    // difference below 2^(PMW-1): the spread is at most BM_MAX * M once all
+    // states are reachable, plus BM_STEP for the branch metrics of one ACS
+    // step, and the 2^(PMW-2) start metric of states != 0 must exceed every
+    // real metric of the first M steps. PM_WIDTH = 0 picks that minimum
+    // (6 bits for K = 5..7, 9 with SOFT = 3); c-tests/test_pm_modulo.c
+    // checks the bound. Plain compares need the largest metric itself to
+    // fit in PMW-1 bits, below the 2^(PMW-1)-1 start of states != 0: the
+    // best path gains at most BM_MAX per symbol over every ACS pass of the
+    // frame, the others are within BM_MAX * M of it (8 bits for
+    // MAX_FRAME = 32, 11 with SOFT = 3)
+    localparam BM_STEP    = R4 ? 2 * BM_MAX : BM_MAX;
+    localparam PM_SYMS    = MAX_FRAME * (TAIL_BITE + 1);
+    localparam PM_MIN_W   = PM_MODULO ? $clog2(BM_MAX * M + BM_STEP + 1) + 2 :
+                            $clog2(BM_MAX * (PM_SYMS + M) + BM_STEP + 1) + 1;
+    localparam PMW        = (PM_WIDTH != 0) ? PM_WIDTH : PM_MIN_W;
 
     wire rst = ~rst_n;
 
     // Interface
     wire byte_valid = ui_in[0];
+    wire trunc_cmd  = ui_in[1];
+    wire tbite_cmd  = ui_in[2];
     wire start_cmd  = ui_in[3];
     wire read_ack   = ui_in[4];
+    wire [2:0] chan_cmd = ui_in[7:5];
 
     // FSM states
     localparam [2:0] S_IDLE       = 3'd0,
@@ -59,16 +298,101 @@ module tt_um_ashvin_viterbi #(
 
     reg [2:0] state;
 
-    // Symbol buffer
-    reg [MAX_FRAME*2-1:0] sym_buf;
+    // Symbol buffer, NSLOT frames of MAX_FRAME symbols
+    reg [NSLOT*MAX_FRAME*SYM_W-1:0] sym_buf;
     reg [FRAME_BITS-1:0]  sym_count;
     reg [FRAME_BITS-1:0]  frame_len;
+    reg                   rx_open;      // CT: frame still receiving, no START yet
+    reg                   frame_trunc;  // frame closed with TRUNC: no tail
+    reg                   frame_tbite;  // frame closed with TBITE: tail-biting
+
+    // Ping-pong slots (NBUF = 2): the frame being received, decoded and
+    // drained; rx_full / ob_full mark a slot's symbols / decoded bits valid.
+    // MC receives into the slot of chan_cmd, counting in rx_len, and the
+    // decode / drain pointers step round robin over the full slots
+    reg [SLOT_W-1:0]      rx_sel, dec_sel, out_sel;
+    reg [NSLOT-1:0]       rx_full, ob_full;
+    reg [FRAME_BITS-1:0]  rx_len   [0:NSLOT-1];
+    reg [NSLOT-1:0]       rx_trunc;
+    reg [NSLOT-1:0]       rx_tbite;
+    reg [FRAME_BITS-1:0]  ob_total [0:NSLOT-1];
+    reg [1:0]             ch_off   [0:NSLOT-1];
+    reg [SMP_W-1:0]       ch_held  [0:NSLOT-1];
+
+    // Slot offsets into sym_buf / out_buf (constant 0 when NBUF = 1)
+    wire [SLOT_W-1:0]     rx_slot  = MC ? chan_cmd[SLOT_W-1:0] : PP ? rx_sel : {SLOT_W{1'b0}};
+    wire [SLOT_W-1:0]     dec_slot = PP ? dec_sel : {SLOT_W{1'b0}};
+    wire [SLOT_W-1:0]     out_slot = PP ? out_sel : {SLOT_W{1'b0}};
+    wire [SLOT_W-1:0]     rx_nx    = (rx_sel  == NSLOT - 1) ? {SLOT_W{1'b0}} : rx_sel + 1'b1;
+    wire [SLOT_W-1:0]     dec_nx   = (dec_sel == NSLOT - 1) ? {SLOT_W{1'b0}} : dec_sel + 1'b1;
+    wire [SLOT_W-1:0]     out_nx   = (out_sel == NSLOT - 1) ? {SLOT_W{1'b0}} : out_sel + 1'b1;
+    // MC: chan_cmd names a channel that exists, and the symbols its open
+    // frame has so far
+    wire                  ch_ok    = !MC || chan_cmd < NCTX;
+    wire [FRAME_BITS-1:0] ch_count = rx_len[rx_slot];
+
+    // Input FIFO head entry {tbite, trunc, start, byte}; with IFIFO the
+    // receive side takes its byte from there instead of uio_in
+    wire [10:0]           if_head;
+    wire                  if_empty, if_full, if_afull, if_aempty;
+    wire                  if_room;    // a byte fits and leaves room for START
+    wire [7:0]            rx_byte  = IFIFO ? if_head[7:0] : uio_in;
+
+    // Symbols of rx_byte, rx_n of them. PUNCT depunctures them
+    // from the pattern offset and held unit the frame's earlier bytes left;
+    // the first byte taken in S_IDLE starts a fresh pattern
+    wire [BYTE_W-1:0]     rx_syms;
+    wire [3:0]            rx_n;
+    reg  [1:0]            dp_off;
+    reg  [SMP_W-1:0]      dp_held;
+    wire [1:0]            dp_off_nx;
+    wire [SMP_W-1:0]      dp_held_nx;
+
+    generate
+        if (PUNCT) begin : g_punct
+            wire dp_fresh = !PP && state == S_IDLE;
+
+            depuncture #(.PUNCT(PUNCT), .SOFT(SOFT)) dp_inst (
+                .in_byte (rx_byte),
+                .off     (dp_fresh ? 2'd0 : MC ? ch_off[rx_slot] : dp_off),
+                .held    (MC ? ch_held[rx_slot] : dp_held),
+                .syms    (rx_syms),
+                .n       (rx_n),
+                .off_nx  (dp_off_nx),
+                .held_nx (dp_held_nx)
+            );
+        end else begin : g_unpunct
+            assign rx_syms    = rx_byte[BYTE_W-1:0];
+            assign rx_n       = SYM_PB;
+            assign dp_off_nx  = 2'd0;
+            assign dp_held_nx = {SMP_W{1'b0}};
+        end
+    endgenerate
 
     // ACS sweep
     reg [FRAME_BITS-1:0]  acs_time;
     reg [STATE_BITS-1:0]  sweep_idx;
 
-    localparam SURV_ABITS = $clog2(MAX_FRAME);
+    // Survivor columns and decision bits per state. SURV_DEPTH below the
+    // frame turns the survivor memory into a ring of that many steps, with
+    // a windowed traceback whenever it is full (SURV_WIN)
+    localparam SURV_FRAME = R4 ? MAX_FRAME / 2 : MAX_FRAME;
+    localparam REGX       = (REG_EXCHANGE != 0);
+    localparam SURV_WIN   = !REGX && (SURV_DEPTH != 0) &&
+                            ((R4 ? SURV_DEPTH / 2 : SURV_DEPTH) < SURV_FRAME);
+    // PAIR: radix-2 columns stored two per word, traced back two per cycle
+    localparam PAIR       = (TB_PAIR != 0) && !R4 && !REGX && !SURV_WIN;
+    // Best-state search: asked for, or needed by the window traceback and
+    // tail-biting decode
+    localparam BEST       = BEST_SEARCH || SURV_WIN || (TAIL_BITE != 0);
+    localparam SURV_D     = SURV_WIN ? (R4 ? SURV_DEPTH / 2 : SURV_DEPTH) :
+                            PAIR     ? (MAX_FRAME + 1) / 2 : SURV_FRAME;
+    localparam ACS_DW     = R4 ? 2 : 1;
+    localparam SURV_DW    = (R4 || PAIR) ? 2 : 1;
+    localparam SURV_ABITS = $clog2(SURV_D);
+    // Columns a window traceback decides; the other 3/4 of the ring are
+    // its convergence depth
+    localparam WIN_B      = SURV_D / 4;
 
     // Survivor memory interface
     reg                       surv_init_frame;
@@ -77,34 +401,59 @@ module tt_um_ashvin_viterbi #(
     wire [SURV_ABITS-1:0]     surv_wr_ptr;
     reg  [STATE_BITS-1:0]     surv_rd_state;
     reg  [SURV_ABITS-1:0]     surv_rd_time;
-    wire                      surv_bit;
+    wire [SURV_DW-1:0]        surv_bit;
+    wire                      surv_wr;
+    wire [ACS_DW*NUM_STATES-1:0] surv_wr_row;
 
     // PM bank interface
     reg                    pm_init_frame;
     reg                    pm_swap_banks;
     reg                    pm_wr_en;
     reg  [STATE_BITS-1:0]  pm_wr_idx;
-    reg  [PM_WIDTH-1:0]    pm_wr_data;
-    wire [PM_WIDTH-1:0]    pm_rd0;
-    wire [PM_WIDTH-1:0]    pm_rd1;
+    reg  [SPC*PMW-1:0]     pm_wr_data;
     wire                   pm_prev_A;
 
-    // Find-best
-    reg [STATE_BITS-1:0]  scan_idx;
-    reg [PM_WIDTH-1:0]    best_metric;
+    // Find-best: running minimum over the current trellis step
+    reg [PMW-1:0]         best_metric;
     reg [STATE_BITS-1:0]  best_state;
 
-    // Traceback
+    // Traceback. win_base is the oldest undecided column, the ring holds
+    // columns win_base .. acs_time - 1; tb_win marks a window traceback
     reg [FRAME_BITS-1:0]  tb_time;
     reg [STATE_BITS-1:0]  tb_state;
+    reg [FRAME_BITS-1:0]  win_base;
+    reg                   tb_win;
+    reg                   tb_lone;      // PAIR / R4: next step is the odd last column
+    reg                   tb_circ;      // tail-biting: first circle, nothing written
+    reg [1:0]             wrap_cnt;     // tail-biting warm-up passes done
+    wire [FRAME_BITS-1:0] tb_stop = SURV_WIN ? win_base : {FRAME_BITS{1'b0}};
 
-    // Output buffer
-    reg [MAX_FRAME-1:0]   out_buf;
+    // Output buffer, NSLOT frames of MAX_FRAME bits
+    reg [NSLOT*MAX_FRAME-1:0] out_buf;
     reg [FRAME_BITS-1:0]  out_total;
     reg                   frame_done;
     reg [7:0]             out_byte_reg;
     reg                   out_byte_valid;
     reg [FRAME_BITS-1:0]  out_byte_pos;
+    reg                   ob_left;      // OUT_OVL: bytes still to send
+
+    // Tail-biting decode: needs the best end state and the whole frame's
+    // survivors. Without CUT_THROUGH the flag is known by ACS_INIT, so the
+    // start metrics are flat
+    localparam TBITE      = (TAIL_BITE != 0) && !REGX && !SURV_WIN;
+    wire                  tbite_on     = TBITE && frame_tbite;
+    wire                  pm_init_flat = tbite_on && !CT;
+
+    // Data bits of the frame; the tail carries none, a truncated or
+    // tail-biting frame has no tail
+    wire                  trunc_on   = BEST && frame_trunc;
+    wire [FRAME_BITS-1:0] frame_bits = (trunc_on || tbite_on) ? frame_len :
+                                       (frame_len > M) ? frame_len - M : 0;
+
+    // OUT_OVL: lowest out_buf bit the traceback writes this cycle, and
+    // out_buf padded so a byte select never runs off the end
+    wire [FRAME_BITS:0]   tb_bit      = (R4 || PAIR) ? tb_time * 2 : tb_time;
+    wire [NSLOT*MAX_FRAME+7:0] out_buf_pad = {8'b0, out_buf};
 
     // ACS init counter
     reg [1:0] init_cnt;
@@ -112,36 +461,212 @@ module tt_um_ashvin_viterbi #(
     // =========================================================================
     // ACS datapath
     // =========================================================================
-    wire [STATE_BITS-1:0] pred0_acs = sweep_idx >> 1;
-    wire [STATE_BITS-1:0] pred1_acs = (sweep_idx >> 1) | (1 << (M - 1));
-    wire                  input_bit = sweep_idx[0];
+    wire [SYM_W-1:0] current_sym = sym_buf[(dec_slot * MAX_FRAME + acs_time) * SYM_W +: SYM_W];
+
+    // New metrics / decisions of the SPC states handled this cycle
+    wire [SPC*PMW-1:0] acs_pm_vec;
+    wire [SPC-1:0]          acs_surv_vec;
+    // PIPE: they belong to state acs_out_idx, valid with acs_out_valid;
+    // acs_pend while an issued state has not come out yet
+    wire                    acs_out_valid;
+    wire [STATE_BITS-1:0]   acs_out_idx;
+    wire                    acs_pend;
+
+    // Last S_ACS step / survivor column of the frame
+    wire [FRAME_BITS-1:0]   acs_last = R4 ? (frame_len - 1) >> 1 : frame_len - 1;
+    // ... and the survivor word it lands in
+    wire [FRAME_BITS-1:0]   tb_last  = PAIR ? acs_last >> 1 : acs_last;
+    // Odd frame: radix-4 runs its last symbol as one radix-2 step (only
+    // SOFT and PUNCT take an odd number of symbols per byte), and PAIR /
+    // R4 trace that lone column in a cycle of its own
+    localparam              R4_ODD   = R4 && (SOFT != 0 || PUNCT != 0);
+    wire                    acs_half = R4_ODD && frame_len[0] && !rx_open && acs_time == acs_last;
+    wire                    tb_odd   = (PAIR || R4_ODD) && frame_len[0];
 
-    // Muxed read addresses: during FIND_BEST, read scan_idx via rd_idx0
-    wire [M-1:0] pm_rd_addr0 = (state == S_FIND_BEST) ? scan_idx[M-1:0] : pred0_acs[M-1:0];
-    wire [M-1:0] pm_rd_addr1 = pred1_acs[M-1:0];
+    // CT: the symbol(s) of step acs_time have landed; S_ACS holds otherwise.
+    // Radix-4 needs both, or once START has closed the frame its odd last
+    // symbol alone
+    wire                    acs_avail = R4 ? acs_time * 2 + 1 < sym_count ||
+                                             (!rx_open && acs_time * 2 < sym_count)
+                                           : acs_time < sym_count;
+    wire                    acs_go    = !CT || acs_avail;
+    // SURV_WIN: the ring is full and step acs_time would overwrite win_base,
+    // so a window traceback runs first. Checked only once the step's symbol
+    // is in, so the last step of a frame never triggers one
+    wire                    win_due   = SURV_WIN && (acs_time - win_base == SURV_D);
+    wire                    acs_run   = acs_go && !win_due;
+    wire                    acs_step  = (state == S_ACS) && acs_run;
 
-    wire [1:0] current_sym = sym_buf[acs_time * 2 +: 2];
+    // New metrics of every state the ACS writes this cycle (all S in the
+    // radix-4 datapath) and the smallest of them
+    localparam STEP_N  = R4 ? NUM_STATES : SPC;
+    localparam STEP_IW = (STEP_N > 1) ? $clog2(STEP_N) : 1;
+    wire [STEP_N*PMW-1:0] step_pm_vec;
+    wire [PMW-1:0]        step_min_pm;
+    wire [STEP_IW-1:0]    step_min_idx;
+    wire                  step_better;
 
-    wire [1:0] exp0, exp1;
-    wire [Wb-1:0] bm0, bm1;
-    wire [PM_WIDTH-1:0] acs_pm_out;
-    wire                acs_surv;
+    pm_argmin #(.N(STEP_N), .Wm(PMW), .MODULO(PM_MODULO)) best_inst (
+        .pm      (step_pm_vec),
+        .min_pm  (step_min_pm),
+        .min_idx (step_min_idx)
+    );
+
+    pm_lt #(.Wm(PMW), .MODULO(PM_MODULO)) best_lt (
+        .a  (step_min_pm),
+        .b  (best_metric),
+        .lt (step_better)
+    );
 
     // =========================================================================
     // Status outputs
     // =========================================================================
-    wire byte_in_ready = (state == S_IDLE) || (state == S_RECEIVE);
-    wire busy          = (state != S_IDLE) && (state != S_RECEIVE) && (state != S_OUTPUT);
+    // Output FIFO head; uio is driven while an output byte is on the pins.
+    // in_room: the receive side could take a byte if uio were free
+    wire [7:0] of_head;
+    wire       of_empty, of_full, of_afull, of_gap;
+    wire       uio_busy      = OFIFO ? !of_empty && !of_gap : out_byte_valid;
+    wire       in_room       = ch_ok && (IFIFO ? if_room : !rx_full[rx_slot]);
+
+    wire byte_in_ready = PP ? in_room && !uio_busy
+                            : (state == S_IDLE) || (state == S_RECEIVE) || rx_open;
+    wire busy          = PP ? (state != S_IDLE)
+                            : (state != S_IDLE) && (state != S_RECEIVE) && (state != S_OUTPUT);
+    wire done          = PP ? (state == S_IDLE) && !(|rx_full) && !(|ob_full) && !out_byte_valid &&
+                              if_empty && of_empty
+                            : frame_done;
 
-    assign uo_out[0]   = byte_in_ready;
-    assign uo_out[1]   = out_byte_valid;
-    assign uo_out[2]   = 1'b0;
-    assign uo_out[3]   = busy;
-    assign uo_out[4]   = frame_done;
-    assign uo_out[7:5] = 3'b0;
+    // Ping-pong receive side commands: the pins, or the input FIFO's head
+    // entry, taken once slot rx_sel is free. The drain hands out_byte_reg
+    // on when the host acknowledges it, or as soon as the output FIFO has
+    // room
+    wire       pp_start = IFIFO ? !if_empty && if_head[8] : start_cmd;
+    wire       pp_trunc = IFIFO ? if_head[9] : trunc_cmd;
+    wire       pp_tbite = IFIFO ? if_head[10] : tbite_cmd;
+    wire       pp_byte  = IFIFO ? !if_empty && !if_head[8] && !rx_full[rx_slot]
+                                : byte_valid && byte_in_ready;
+    wire       ob_ack   = OFIFO ? !of_full : read_ack;
 
-    assign uio_out = out_byte_valid ? out_byte_reg : 8'b0;
-    assign uio_oe  = {8{out_byte_valid}};
+    generate
+        if (IFIFO) begin : g_in_fifo
+            // A byte on the START cycle is dropped, as without the FIFO.
+            // Bytes leave the last entry free for START
+            localparam IF_AW = $clog2(IN_FIFO);
+            wire [IF_AW:0] if_level;
+
+            assign if_room = if_level < IN_FIFO - 1;
+
+            sync_fifo #(.W(11), .D(IN_FIFO)) in_fifo (
+                .clk    (clk),
+                .rst    (rst),
+                .push   (start_cmd || (byte_valid && !uio_busy && if_room)),
+                .din    ({tbite_cmd, trunc_cmd, start_cmd, uio_in}),
+                .pop    (!rx_full[rx_slot]),
+                .dout   (if_head),
+                .empty  (if_empty),
+                .full   (if_full),
+                .afull  (if_afull),
+                .aempty (if_aempty),
+                .level  (if_level)
+            );
+        end else begin : g_no_in_fifo
+            assign if_room   = 1'b0;
+            assign if_head   = 11'b0;
+            assign if_empty  = 1'b1;
+            assign if_full   = 1'b0;
+            assign if_afull  = 1'b0;
+            assign if_aempty = 1'b0;
+        end
+
+        if (OFIFO) begin : g_out_fifo
+            // uio is released for the cycle after each READ_ACK, so the
+            // host can slip an input byte in between, as it can with
+            // out_byte_reg alone, and for as long as BYTE_VALID is held
+            // with room for the byte, so input does not wait for the
+            // host to read the queued output
+            reg                       gap_q;
+            wire                      of_aempty;
+            wire [$clog2(OUT_FIFO):0] of_level;
+
+            always @(posedge clk) begin
+                if (rst)
+                    gap_q <= 0;
+                else
+                    gap_q <= (read_ack && uio_busy) || (byte_valid && in_room);
+            end
+
+            assign of_gap = gap_q;
+
+            sync_fifo #(.W(8), .D(OUT_FIFO)) out_fifo (
+                .clk    (clk),
+                .rst    (rst),
+                .push   (out_byte_valid),
+                .din    (out_byte_reg),
+                .pop    (read_ack && uio_busy),
+                .dout   (of_head),
+                .empty  (of_empty),
+                .full   (of_full),
+                .afull  (of_afull),
+                .aempty (of_aempty),
+                .level  (of_level)
+            );
+
+            wire _unused_of = &{of_aempty, of_level, 1'b0};
+        end else begin : g_no_out_fifo
+            assign of_head  = 8'b0;
+            assign of_empty = 1'b1;
+            assign of_full  = 1'b0;
+            assign of_afull = 1'b0;
+            assign of_gap   = 1'b0;
+        end
+    endgenerate
+
+    generate
+        if (CONTINUOUS) begin : g_stream
+            // The frame datapath below is left unconnected and optimised away
+            wire       st_in_ready, st_out_valid, st_busy;
+            wire [7:0] st_out_byte;
+
+            viterbi_stream #(
+                .K(K), .G0_OCT(G0_OCT), .G1_OCT(G1_OCT),
+                .D(TB_DEPTH), .TB_BLOCK(TB_BLOCK), .PM_WIDTH(PMW), .PM_MODULO(PM_MODULO)
+            ) stream_inst (
+                .clk       (clk),
+                .rst       (rst),
+                .restart   (start_cmd),
+                .in_valid  (byte_valid),
+                .in_ready  (st_in_ready),
+                .in_byte   (uio_in),
+                .out_valid (st_out_valid),
+                .out_ack   (read_ack),
+                .out_byte  (st_out_byte),
+                .busy      (st_busy)
+            );
+
+            assign uo_out[0]   = st_in_ready;
+            assign uo_out[1]   = st_out_valid;
+            assign uo_out[2]   = 1'b0;
+            assign uo_out[3]   = st_busy;
+            assign uo_out[4]   = 1'b0;
+            assign uo_out[7:5] = 3'b0;
+
+            assign uio_out = st_out_valid ? st_out_byte : 8'b0;
+            assign uio_oe  = {8{st_out_valid}};
+
+            wire _unused_frame = &{byte_in_ready, busy, done, out_byte_reg,
+                                   uio_busy, of_head, of_afull, if_afull, if_aempty, 1'b0};
+        end else begin : g_frame
+            assign uo_out[0]   = byte_in_ready;
+            assign uo_out[1]   = uio_busy;
+            assign uo_out[2]   = 1'b0;
+            assign uo_out[3]   = busy;
+            assign uo_out[4]   = done;
+            assign uo_out[7:5] = MC ? out_slot : {of_afull, if_aempty, if_afull};
+
+            assign uio_out = !uio_busy ? 8'b0 : OFIFO ? of_head : out_byte_reg;
+            assign uio_oe  = {8{uio_busy}};
+        end
+    endgenerate
 
     wire _unused = &{ena, 1'b0};
 
@@ -149,65 +674,241 @@ module tt_um_ashvin_viterbi #(
     // Submodule instantiations
     // =========================================================================
 
-    expected_bits #(
-        .K(K), .G0_OCT(G0_OCT), .G1_OCT(G1_OCT)
-    ) eb0 (
-        .pred     (pred0_acs[M-1:0]),
-        .b        (input_bit),
-        .expected (exp0)
-    );
+    generate
+        if (R4) begin : g_acs_r4
+            wire [SYM_W-1:0] sym0 = sym_buf[(dec_slot * MAX_FRAME + acs_time * 2) * SYM_W +: SYM_W];
+            wire [SYM_W-1:0] sym1 = sym_buf[(dec_slot * MAX_FRAME + acs_time * 2 + 1) * SYM_W +: SYM_W];
+            wire [NUM_STATES*PMW-1:0] pm_all;
 
-    expected_bits #(
-        .K(K), .G0_OCT(G0_OCT), .G1_OCT(G1_OCT)
-    ) eb1 (
-        .pred     (pred1_acs[M-1:0]),
-        .b        (input_bit),
-        .expected (exp1)
-    );
+            acs4_unit #(
+                .K(K), .G0_OCT(G0_OCT), .G1_OCT(G1_OCT),
+                .Wm(PMW), .Wb(Wb), .MODULO(PM_MODULO), .SOFT(SOFT),
+                .PUNCT(PUNCT)
+            ) acs_inst (
+                .clk        (clk),
+                .rst        (rst),
+                .init_frame (pm_init_frame),
+                .init_flat  (pm_init_flat),
+                .rx_sym0    (sym0),
+                .rx_sym1    (sym1),
+                .half       (acs_half),
+                .wr_en      (acs_step),
+                .pm_out     (pm_all),
+                .dec        (surv_wr_row)
+            );
 
-    branch_metric #(.Wb(Wb)) bm_inst (
-        .rx_sym   (current_sym),
-        .exp_sym0 (exp0),
-        .exp_sym1 (exp1),
-        .bm0      (bm0),
-        .bm1      (bm1)
-    );
+            assign surv_wr      = acs_step;
+            assign step_pm_vec  = pm_all;
+            assign acs_pm_vec   = {(SPC*PMW){1'b0}};
+            assign acs_surv_vec = {SPC{1'b0}};
+            assign pm_prev_A    = 1'b1;
 
-    acs_core #(.Wm(PM_WIDTH), .Wb(Wb)) acs_inst (
-        .pm0    (pm_rd0),
-        .pm1    (pm_rd1),
-        .bm0    (bm0),
-        .bm1    (bm1),
-        .pm_out (acs_pm_out),
-        .surv   (acs_surv)
-    );
+            wire _unused_r4 = &{current_sym, pm_swap_banks, pm_wr_en,
+                                pm_wr_idx, pm_wr_data, surv_wr_en, surv_row, 1'b0};
+        end else if (PIPE) begin : g_acs_pipe
+            acs_pipe #(
+                .K(K), .G0_OCT(G0_OCT), .G1_OCT(G1_OCT),
+                .Wm(PMW), .Wb(Wb), .MODULO(PM_MODULO), .SOFT(SOFT),
+                .PUNCT(PUNCT)
+            ) acs_inst (
+                .clk        (clk),
+                .rst        (rst),
+                .init_frame (pm_init_frame),
+                .init_flat  (pm_init_flat),
+                .in_valid   (acs_step),
+                .in_idx     (sweep_idx[M-1:0]),
+                .rx_sym     (current_sym),
+                .out_valid  (acs_out_valid),
+                .out_idx    (acs_out_idx[M-1:0]),
+                .out_pm     (acs_pm_vec),
+                .out_surv   (acs_surv_vec),
+                .pend       (acs_pend)
+            );
 
-    pm_bank #(.K(K), .Wm(PM_WIDTH)) pm_inst (
-        .clk        (clk),
-        .rst        (rst),
-        .init_frame (pm_init_frame),
-        .rd_idx0    (pm_rd_addr0),
-        .rd_idx1    (pm_rd_addr1),
-        .wr_en      (pm_wr_en),
-        .wr_idx     (pm_wr_idx[M-1:0]),
-        .wr_pm      (pm_wr_data),
-        .swap_banks (pm_swap_banks),
-        .rd_pm0     (pm_rd0),
-        .rd_pm1     (pm_rd1),
-        .prev_A     (pm_prev_A)
-    );
+            assign surv_wr     = surv_wr_en;
+            assign surv_wr_row = surv_row;
+            assign step_pm_vec = acs_pm_vec;
+            assign pm_prev_A   = 1'b1;
 
-    survivor_mem #(.K(K), .Wm(PM_WIDTH), .D(MAX_FRAME)) surv_inst (
-        .clk        (clk),
-        .rst        (rst),
-        .init_frame (surv_init_frame),
-        .wr_en      (surv_wr_en),
-        .surv_row   (surv_row),
-        .wr_ptr     (surv_wr_ptr),
-        .rd_state   (surv_rd_state[M-1:0]),
-        .rd_time    (surv_rd_time),
-        .surv_bit   (surv_bit)
-    );
+            wire _unused_pipe = &{pm_swap_banks, pm_wr_en, pm_wr_idx, pm_wr_data, 1'b0};
+        end else if (ACS_PAR == 0) begin : g_acs_serial
+            wire [STATE_BITS-1:0] pred0_acs = sweep_idx >> 1;
+            wire [STATE_BITS-1:0] pred1_acs = (sweep_idx >> 1) | (1 << (M - 1));
+            wire                  input_bit = sweep_idx[0];
+
+            wire [M-1:0] pm_rd_addr0 = pred0_acs[M-1:0];
+            wire [M-1:0] pm_rd_addr1 = pred1_acs[M-1:0];
+
+            wire [1:0]          exp0, exp1;
+            wire [Wb-1:0]       bm0, bm1;
+            wire [PMW-1:0] pm_rd0, pm_rd1;
+
+            expected_bits #(
+                .K(K), .G0_OCT(G0_OCT), .G1_OCT(G1_OCT)
+            ) eb0 (
+                .pred     (pred0_acs[M-1:0]),
+                .b        (input_bit),
+                .expected (exp0)
+            );
+
+            expected_bits #(
+                .K(K), .G0_OCT(G0_OCT), .G1_OCT(G1_OCT)
+            ) eb1 (
+                .pred     (pred1_acs[M-1:0]),
+                .b        (input_bit),
+                .expected (exp1)
+            );
+
+            branch_metric #(.Wb(Wb), .SOFT(SOFT), .PUNCT(PUNCT)) bm_inst (
+                .rx_sym   (current_sym),
+                .exp_sym0 (exp0),
+                .exp_sym1 (exp1),
+                .bm0      (bm0),
+                .bm1      (bm1)
+            );
+
+            acs_core #(.Wm(PMW), .Wb(Wb), .MODULO(PM_MODULO)) acs_inst (
+                .pm0    (pm_rd0),
+                .pm1    (pm_rd1),
+                .bm0    (bm0),
+                .bm1    (bm1),
+                .pm_out (acs_pm_vec),
+                .surv   (acs_surv_vec)
+            );
+
+            pm_bank #(.K(K), .Wm(PMW), .MODULO(PM_MODULO)) pm_inst (
+                .clk        (clk),
+                .rst        (rst),
+                .init_frame (pm_init_frame),
+                .init_flat  (pm_init_flat),
+                .rd_idx0    (pm_rd_addr0),
+                .rd_idx1    (pm_rd_addr1),
+                .wr_en      (pm_wr_en),
+                .wr_idx     (pm_wr_idx[M-1:0]),
+                .wr_pm      (pm_wr_data),
+                .swap_banks (pm_swap_banks),
+                .rd_pm0     (pm_rd0),
+                .rd_pm1     (pm_rd1),
+                .prev_A     (pm_prev_A)
+            );
+
+            assign surv_wr     = surv_wr_en;
+            assign surv_wr_row = surv_row;
+            assign step_pm_vec = acs_pm_vec;
+        end else begin : g_acs_par
+            // sweep_idx counts butterfly groups; group g writes PM row g
+            localparam GB = (NUM_GROUPS > 1) ? $clog2(NUM_GROUPS) : 1;
+
+            acs_unit #(
+                .K(K), .G0_OCT(G0_OCT), .G1_OCT(G1_OCT),
+                .Wm(PMW), .Wb(Wb), .MODULO(PM_MODULO), .SOFT(SOFT),
+                .PUNCT(PUNCT), .P(ACS_PAR)
+            ) acs_inst (
+                .clk        (clk),
+                .rst        (rst),
+                .init_frame (pm_init_frame),
+                .init_flat  (pm_init_flat),
+                .swap_banks (pm_swap_banks),
+                .rd_grp     (sweep_idx[GB-1:0]),
+                .rx_sym     (current_sym),
+                .wr_en      (ACS_FULL ? acs_step : pm_wr_en),
+                .wr_row     (pm_wr_idx[GB-1:0]),
+                .wr_pm      (ACS_FULL ? acs_pm_vec : pm_wr_data),
+                .pm_out     (acs_pm_vec),
+                .surv       (acs_surv_vec),
+                .prev_A     (pm_prev_A)
+            );
+
+            assign surv_wr     = ACS_FULL ? acs_step : surv_wr_en;
+            assign surv_wr_row = ACS_FULL ? acs_surv_vec : surv_row;
+            assign step_pm_vec = acs_pm_vec;
+        end
+
+        if (!PIPE) begin : g_acs_nopipe
+            assign acs_out_valid = 1'b0;
+            assign acs_out_idx   = {STATE_BITS{1'b0}};
+            assign acs_pend      = 1'b0;
+        end
+    endgenerate
+
+    // PAIR: even columns wait in pair_row; the odd one writes the pair
+    wire                          surv_mem_wr;
+    wire [SURV_DW*NUM_STATES-1:0] surv_mem_row;
+    wire                          pair_bit;     // unpaired column, at tb_state
+
+    generate
+        if (PAIR) begin : g_surv_pair
+            reg [NUM_STATES-1:0] pair_row;
+            reg                  pair_odd;      // pair_row holds column 2j
+
+            always @(posedge clk) begin
+                if (rst || surv_init_frame) begin
+                    pair_odd <= 0;
+                end else if (surv_wr) begin
+                    pair_odd <= !pair_odd;
+                    if (!pair_odd)
+                        pair_row <= surv_wr_row;
+                end
+            end
+
+            // State s at column 2j+1 came from p = {d, s} >> 1 at column
+            // 2j, which came from {d(2j)[p], p} >> 1: the radix-4 {x, s} >> 2
+            genvar ps;
+            for (ps = 0; ps < NUM_STATES; ps = ps + 1) begin : g_pair
+                wire          d1 = surv_wr_row[ps];
+                wire [M-1:0]  p  = (ps >> 1) | (d1 << (M - 1));
+                assign surv_mem_row[ps*2 +: 2] = {pair_row[p], d1};
+            end
+
+            assign surv_mem_wr = surv_wr && pair_odd;
+            assign pair_bit    = pair_row[tb_state[M-1:0]];
+        end else begin : g_surv_col
+            assign surv_mem_wr  = surv_wr;
+            assign surv_mem_row = surv_wr_row;
+            assign pair_bit     = 1'b0;
+        end
+    endgenerate
+
+    // REGX: decoded bits of the path into surv_rd_state, out_buf order
+    wire [MAX_FRAME-1:0]      regx_path;
+
+    generate
+        if (REGX) begin : g_surv_regx
+            reg_exchange #(
+                .K(K), .D(SURV_D), .DW(SURV_DW)
+            ) surv_inst (
+                .clk        (clk),
+                .rst        (rst),
+                .init_frame (surv_init_frame),
+                .wr_en      (surv_wr),
+                .surv_row   (surv_wr_row),
+                .half       (acs_half),
+                .rd_state   (surv_rd_state[M-1:0]),
+                .path       (regx_path)
+            );
+
+            assign surv_wr_ptr = {SURV_ABITS{1'b0}};
+            assign surv_bit    = {SURV_DW{1'b0}};
+
+            wire _unused_regx = &{surv_rd_time, 1'b0};
+        end else begin : g_surv_mem
+            survivor_mem #(
+                .K(K), .Wm(PMW), .D(SURV_D), .DW(SURV_DW)
+            ) surv_inst (
+                .clk        (clk),
+                .rst        (rst),
+                .init_frame (surv_init_frame),
+                .wr_en      (surv_mem_wr),
+                .surv_row   (surv_mem_row),
+                .wr_ptr     (surv_wr_ptr),
+                .rd_state   (surv_rd_state[M-1:0]),
+                .rd_time    (surv_rd_time),
+                .surv_bit   (surv_bit)
+            );
+
+            assign regx_path = {MAX_FRAME{1'b0}};
+        end
+    endgenerate
 
     // =========================================================================
     // FSM
@@ -219,20 +920,30 @@ module tt_um_ashvin_viterbi #(
             state          <= S_IDLE;
             sym_count      <= 0;
             frame_len      <= 0;
+            rx_open        <= 0;
+            frame_trunc    <= 0;
+            frame_tbite    <= 0;
             acs_time       <= 0;
             sweep_idx      <= 0;
-            scan_idx       <= 0;
-            best_metric    <= {PM_WIDTH{1'b1}};
+            best_metric    <= {PMW{1'b1}};
             best_state     <= 0;
             tb_time        <= 0;
             tb_state       <= 0;
+            win_base       <= 0;
+            tb_win         <= 0;
+            tb_lone        <= 0;
+            tb_circ        <= 0;
+            wrap_cnt       <= 0;
             out_buf        <= 0;
             out_total      <= 0;
             frame_done     <= 0;
             out_byte_reg   <= 0;
             out_byte_valid <= 0;
             out_byte_pos   <= 0;
+            ob_left        <= 0;
             sym_buf        <= 0;
+            dp_off         <= 0;
+            dp_held        <= 0;
             surv_init_frame <= 0;
             surv_wr_en     <= 0;
             surv_row       <= 0;
@@ -244,6 +955,19 @@ module tt_um_ashvin_viterbi #(
             pm_wr_idx      <= 0;
             pm_wr_data     <= 0;
             init_cnt       <= 0;
+            rx_sel         <= 0;
+            dec_sel        <= 0;
+            out_sel        <= 0;
+            rx_full        <= 0;
+            ob_full        <= 0;
+            rx_trunc       <= 0;
+            rx_tbite       <= 0;
+            for (k = 0; k < NSLOT; k = k + 1) begin
+                rx_len[k]   <= 0;
+                ob_total[k] <= 0;
+                ch_off[k]   <= 0;
+                ch_held[k]  <= 0;
+            end
         end else begin
             // Deassert one-shot signals each cycle
             pm_init_frame   <= 0;
@@ -252,32 +976,185 @@ module tt_um_ashvin_viterbi #(
             surv_init_frame <= 0;
             surv_wr_en      <= 0;
 
+            if (PIPE && acs_out_valid) begin
+                // acs_pipe results, in state order, two cycles behind
+                // S_ACS: the last state of a step writes the survivor
+                // column, and the running minimum restarts at state 0
+                surv_row[acs_out_idx] <= acs_surv_vec;
+                if (acs_out_idx == NUM_STATES - 1)
+                    surv_wr_en <= 1;
+                if (BEST && (acs_out_idx == 0 || step_better)) begin
+                    best_metric <= step_min_pm;
+                    best_state  <= acs_out_idx;
+                end
+            end
+
+            if (MC) begin
+                // Receive side: the channel on chan_cmd fills its own slot,
+                // START hands it to decode
+                if (start_cmd && ch_ok && !rx_full[rx_slot] && ch_count > 0) begin
+                    rx_full[rx_slot]  <= 1;
+                    rx_trunc[rx_slot] <= trunc_cmd;
+                    rx_tbite[rx_slot] <= tbite_cmd;
+                    ch_off[rx_slot]   <= 0;
+                end else if (byte_valid && byte_in_ready && ch_count < MAX_FRAME) begin
+                    for (k = 0; k < SYM_PB; k = k + 1)
+                        if (k < rx_n && ch_count + k < MAX_FRAME)
+                            sym_buf[(rx_slot * MAX_FRAME + ch_count + k) * SYM_W +: SYM_W] <= rx_syms[k*SYM_W +: SYM_W];
+                    if (ch_count + rx_n <= MAX_FRAME)
+                        rx_len[rx_slot] <= ch_count + rx_n;
+                    else
+                        rx_len[rx_slot] <= MAX_FRAME[FRAME_BITS-1:0];
+                    ch_off[rx_slot]  <= dp_off_nx;
+                    ch_held[rx_slot] <= dp_held_nx;
+                end
+            end else if (PP) begin
+                // Receive side: fill slot rx_sel, START hands it to decode
+                if (pp_start && !rx_full[rx_slot] && sym_count > 0) begin
+                    rx_full[rx_slot] <= 1;
+                    rx_len[rx_slot]  <= sym_count;
+                    rx_trunc[rx_slot] <= pp_trunc;
+                    rx_tbite[rx_slot] <= pp_tbite;
+                    rx_sel           <= rx_nx;
+                    sym_count        <= 0;
+                    dp_off           <= 0;
+                end else if (pp_byte && sym_count < MAX_FRAME) begin
+                    for (k = 0; k < SYM_PB; k = k + 1)
+                        if (k < rx_n && sym_count + k < MAX_FRAME)
+                            sym_buf[(rx_slot * MAX_FRAME + sym_count + k) * SYM_W +: SYM_W] <= rx_syms[k*SYM_W +: SYM_W];
+                    if (sym_count + rx_n <= MAX_FRAME)
+                        sym_count <= sym_count + rx_n;
+                    else
+                        sym_count <= MAX_FRAME[FRAME_BITS-1:0];
+                    dp_off    <= dp_off_nx;
+                    dp_held   <= dp_held_nx;
+                end
+            end
+
+            if (PP) begin
+                // Output side: drain slot out_sel byte by byte, then release
+                // it; MC moves on from an empty slot too
+                if (!out_byte_valid) begin
+                    if (ob_full[out_slot]) begin
+                        if (out_byte_pos < ob_total[out_slot]) begin
+                            for (k = 0; k < 8; k = k + 1) begin
+                                if (out_byte_pos + k < MAX_FRAME)
+                                    out_byte_reg[k] <= out_buf[out_slot * MAX_FRAME + out_byte_pos + k];
+                                else
+                                    out_byte_reg[k] <= 1'b0;
+                            end
+                            out_byte_valid <= 1;
+                        end else begin
+                            ob_full[out_slot] <= 0;
+                            out_byte_pos      <= 0;
+                            out_sel           <= out_nx;
+                        end
+                    end else if (MC) begin
+                        out_sel <= out_nx;
+                    end
+                end else if (ob_ack) begin
+                    out_byte_valid <= 0;
+                    if (out_byte_pos + 8 >= ob_total[out_slot])
+                        out_byte_pos <= ob_total[out_slot];
+                    else
+                        out_byte_pos <= out_byte_pos + 8;
+                end
+            end
+
+            if (CT && rx_open) begin
+                // Cut-through receive alongside the ACS states. A byte on the
+                // START edge is not part of the frame (as in S_RECEIVE), and
+                // is not counted either, so sym_count == frame_len once closed
+                if (start_cmd) begin
+                    frame_len   <= sym_count;
+                    frame_trunc <= trunc_cmd;
+                    frame_tbite <= tbite_cmd;
+                    rx_open     <= 0;
+                end else if (byte_valid && sym_count < MAX_FRAME) begin
+                    for (k = 0; k < SYM_PB; k = k + 1)
+                        if (k < rx_n && sym_count + k < MAX_FRAME)
+                            sym_buf[(sym_count + k)*SYM_W +: SYM_W] <= rx_syms[k*SYM_W +: SYM_W];
+                    if (sym_count + rx_n <= MAX_FRAME)
+                        sym_count <= sym_count + rx_n;
+                    else
+                        sym_count <= MAX_FRAME[FRAME_BITS-1:0];
+                    dp_off  <= dp_off_nx;
+                    dp_held <= dp_held_nx;
+                end
+            end
+
+            if (OUT_OVL && (state == S_TRACE || state == S_OUTPUT)) begin
+                // Last byte first: the byte at out_byte_pos is complete once
+                // the traceback is writing below it
+                if (!out_byte_valid || read_ack) begin
+                    if (ob_left && (state == S_OUTPUT || (!tb_circ && tb_bit < out_byte_pos))) begin
+                        out_byte_reg   <= out_buf_pad[out_byte_pos +: 8];
+                        out_byte_valid <= 1;
+                        if (out_byte_pos == 0)
+                            ob_left      <= 0;
+                        else
+                            out_byte_pos <= out_byte_pos - 8;
+                    end else begin
+                        out_byte_valid <= 0;
+                    end
+                end
+            end
+
             case (state)
 
-                S_IDLE: begin
+                S_IDLE: if (PP) begin
+                    // Decode side: next slot once its symbols are in and its
+                    // output bits from two frames back have been drained
+                    if (rx_full[dec_slot] && !ob_full[dec_slot]) begin
+                        frame_len   <= rx_len[dec_slot];
+                        frame_trunc <= rx_trunc[dec_slot];
+                        frame_tbite <= rx_tbite[dec_slot];
+                        init_cnt    <= 0;
+                        state     <= S_ACS_INIT;
+                    end else if (MC) begin
+                        // Round robin: try the next channel
+                        dec_sel <= dec_nx;
+                    end
+                end else begin
                     frame_done     <= 0;
                     out_byte_valid <= 0;
                     sym_count      <= 0;
                     if (byte_valid) begin
-                        sym_buf[7:0] <= uio_in;
-                        sym_count    <= 4;
-                        state        <= S_RECEIVE;
+                        for (k = 0; k < SYM_PB; k = k + 1)
+                            if (k < rx_n && k < MAX_FRAME)
+                                sym_buf[k*SYM_W +: SYM_W] <= rx_syms[k*SYM_W +: SYM_W];
+                        sym_count    <= rx_n;
+                        dp_off       <= dp_off_nx;
+                        dp_held      <= dp_held_nx;
+                        if (CT) begin
+                            rx_open  <= 1;
+                            init_cnt <= 0;
+                            state    <= S_ACS_INIT;
+                        end else begin
+                            state    <= S_RECEIVE;
+                        end
                     end
                 end
 
                 S_RECEIVE: begin
                     out_byte_valid <= 0;
                     if (byte_valid && sym_count < MAX_FRAME) begin
-                        sym_buf[sym_count*2 +: 8] <= uio_in;
-                        if (sym_count + 4 <= MAX_FRAME)
-                            sym_count <= sym_count + 4;
+                        for (k = 0; k < SYM_PB; k = k + 1)
+                            if (k < rx_n && sym_count + k < MAX_FRAME)
+                                sym_buf[(sym_count + k)*SYM_W +: SYM_W] <= rx_syms[k*SYM_W +: SYM_W];
+                        if (sym_count + rx_n <= MAX_FRAME)
+                            sym_count <= sym_count + rx_n;
                         else
                             sym_count <= MAX_FRAME[FRAME_BITS-1:0];
+                        dp_off  <= dp_off_nx;
+                        dp_held <= dp_held_nx;
                     end
                     if (start_cmd && sym_count > 0) begin
-                        frame_len <= sym_count;
-                        init_cnt  <= 0;
-                        state     <= S_ACS_INIT;
+                        frame_len   <= sym_count;
+                        frame_trunc <= trunc_cmd;
+                        frame_tbite <= tbite_cmd;
+                        init_cnt    <= 0;
+                        state       <= S_ACS_INIT;
                     end
                 end
 
@@ -286,6 +1163,7 @@ module tt_um_ashvin_viterbi #(
                         2'd0: begin
                             pm_init_frame   <= 1;
                             surv_init_frame <= 1;
+                            wrap_cnt        <= 0;
                             init_cnt        <= 2'd1;
                         end
                         2'd1: begin
@@ -296,6 +1174,8 @@ module tt_um_ashvin_viterbi #(
                             acs_time  <= 0;
                             sweep_idx <= 0;
                             surv_row  <= 0;
+                            win_base  <= 0;
+                            tb_win    <= 0;
                             state     <= S_ACS;
                         end
                         default: init_cnt <= 0;
@@ -303,23 +1183,66 @@ module tt_um_ashvin_viterbi #(
                 end
 
                 S_ACS: begin
-                    pm_wr_en   <= 1;
-                    pm_wr_idx  <= sweep_idx;
-                    pm_wr_data <= acs_pm_out;
-                    surv_row[sweep_idx] <= acs_surv;
+                    // The first cycle of each step restarts the minimum, so
+                    // after the last step it is over the final metrics.
+                    // Strict < keeps the lowest state on ties
+                    if (BEST && !PIPE && acs_run &&
+                        (sweep_idx == 0 || step_better)) begin
+                        best_metric <= step_min_pm;
+                        best_state  <= sweep_idx * SPC + step_min_idx;
+                    end
 
-                    if (sweep_idx == NUM_STATES - 1) begin
-                        state <= S_ACS_COMMIT;
+                    if (!acs_go) begin
+                        // CT: wait for the next symbol, or START closed the
+                        // frame after its last step (PIPE: once drained)
+                        if (!rx_open)
+                            state <= PIPE ? S_ACS_COMMIT : S_FIND_BEST;
+                    end else if (win_due) begin
+                        // Ring full: decide its oldest WIN_B columns first
+                        tb_win <= 1;
+                        state  <= PIPE ? S_ACS_COMMIT : S_FIND_BEST;
+                    end else if (PIPE) begin
+                        // State sweep_idx is issued this edge; the next
+                        // step's sweep follows straight on
+                        if (sweep_idx == NUM_STATES - 1) begin
+                            sweep_idx <= 0;
+                            if (acs_time == acs_last && !rx_open)
+                                state    <= S_ACS_COMMIT;
+                            else
+                                acs_time <= acs_time + 1;
+                        end else begin
+                            sweep_idx <= sweep_idx + 1;
+                        end
+                    end else if (ACS_FULL || R4) begin
+                        // Metrics and survivor row are written this edge
+                        if (acs_time == acs_last && !rx_open)
+                            state    <= S_FIND_BEST;
+                        else
+                            acs_time <= acs_time + 1;
                     end else begin
-                        sweep_idx <= sweep_idx + 1;
+                        pm_wr_en   <= 1;
+                        pm_wr_idx  <= sweep_idx;
+                        pm_wr_data <= acs_pm_vec;
+                        surv_row[sweep_idx*SPC +: SPC] <= acs_surv_vec;
+
+                        if (sweep_idx == NUM_GROUPS - 1) begin
+                            state <= S_ACS_COMMIT;
+                        end else begin
+                            sweep_idx <= sweep_idx + 1;
+                        end
                     end
                 end
 
-                S_ACS_COMMIT: begin
+                S_ACS_COMMIT: if (PIPE) begin
+                    // Drain: the last state issued leaves acs_pipe this
+                    // edge once it is past the ACS stage
+                    if (!acs_pend)
+                        state <= S_FIND_BEST;
+                end else begin
                     surv_wr_en    <= 1;
                     pm_swap_banks <= 1;
 
-                    if (acs_time == frame_len - 1) begin
+                    if (acs_time == frame_len - 1 && !rx_open) begin
                         state         <= S_FIND_BEST;
                     end else begin
                         acs_time  <= acs_time + 1;
@@ -328,34 +1251,138 @@ module tt_um_ashvin_viterbi #(
                     end
                 end
 
-                S_FIND_BEST: begin
+                S_FIND_BEST: if (tb_win) begin
+                    // Window traceback from the best state of the newest
+                    // column
+                    tb_state      <= best_state;
+                    surv_rd_state <= best_state;
+                    tb_time       <= acs_time - 1;
+                    surv_rd_time  <= acs_time - 1;
+                    state         <= S_TRACE;
+                end else if (tbite_on && wrap_cnt != TAIL_BITE) begin
+                    // Tail-biting warm-up done: run the frame again from
+                    // the metrics it ended with, survivors from column 0
+                    wrap_cnt        <= wrap_cnt + 1;
+                    surv_init_frame <= 1;
+                    init_cnt        <= 2'd2;
+                    state           <= S_ACS_INIT;
+                end else begin
                     // 1-cycle delay: lets last survivor write complete
-                    // before traceback reads mem[frame_len-1]
-                    tb_state      <= 0;
-                    surv_rd_state <= 0;
-                    tb_time       <= frame_len - 1;
-                    surv_rd_time  <= frame_len - 1;
+                    // before traceback reads mem[frame_len-1]. Terminated
+                    // frames end in state 0, truncated and tail-biting ones
+                    // in the best state
+                    tb_state      <= (trunc_on || tbite_on) ? best_state : {STATE_BITS{1'b0}};
+                    surv_rd_state <= (trunc_on || tbite_on) ? best_state : {STATE_BITS{1'b0}};
+                    tb_time       <= tb_last;
+                    surv_rd_time  <= tb_last;
+                    tb_lone       <= tb_odd;
+                    tb_circ       <= tbite_on;
                     state         <= S_TRACE;
+                    // Symbols are no longer needed: the slot can be refilled
+                    if (PP)
+                        rx_full[dec_slot] <= 0;
+                    // ... and MC's channel counts its next frame from 0
+                    if (MC)
+                        rx_len[dec_slot] <= 0;
+                    // Overlapped drain starts at the highest data byte
+                    if (OUT_OVL) begin
+                        out_total    <= frame_bits;
+                        out_byte_pos <= ((frame_bits - 1) >> 3) << 3;
+                        ob_left      <= (frame_bits != 0);
+                    end
                 end
 
                 S_TRACE: begin
-                    out_buf[tb_time] <= tb_state[0];
-
-                    tb_state      <= {surv_bit, tb_state[STATE_BITS-1:1]};
-                    surv_rd_state <= {surv_bit, tb_state[STATE_BITS-1:1]};
+                    // A window traceback only decides its oldest WIN_B
+                    // columns, a tail-biting first circle none
+                    if (REGX) begin
+                        // The end state's path is the whole frame: one cycle
+                        out_buf[dec_slot * MAX_FRAME +: MAX_FRAME] <= regx_path;
+                    end else if ((R4 || PAIR) && tb_lone) begin
+                        // Odd frame: column 2 tb_time is still in pair_row,
+                        // or R4's half step stored {0, d}
+                        if (!tb_circ)
+                            out_buf[dec_slot * MAX_FRAME + tb_time * 2] <= tb_state[0];
+                        tb_state      <= {R4 ? surv_bit[0] : pair_bit, tb_state[STATE_BITS-1:1]};
+                        surv_rd_state <= {R4 ? surv_bit[0] : pair_bit, tb_state[STATE_BITS-1:1]};
+                        tb_lone       <= 0;
+                    end else if (R4 || PAIR) begin
+                        // Two steps: emit both input bits, p = {x, s} >> 2
+                        if (!tb_circ && (!tb_win || tb_time - win_base < WIN_B)) begin
+                            out_buf[dec_slot * MAX_FRAME + tb_time * 2 + 1] <= tb_state[0];
+                            out_buf[dec_slot * MAX_FRAME + tb_time * 2]     <= tb_state[1];
+                        end
+                        tb_state      <= {surv_bit, tb_state} >> 2;
+                        surv_rd_state <= {surv_bit, tb_state} >> 2;
+                    end else begin
+                        if (!tb_circ && (!tb_win || tb_time - win_base < WIN_B))
+                            out_buf[dec_slot * MAX_FRAME + tb_time] <= tb_state[0];
+                        tb_state      <= {surv_bit, tb_state[STATE_BITS-1:1]};
+                        surv_rd_state <= {surv_bit, tb_state[STATE_BITS-1:1]};
+                    end
 
-                    if (tb_time == 0) begin
-                        out_total      <= frame_len - M;
-                        out_byte_pos   <= 0;
-                        out_byte_valid <= 0;
-                        state          <= S_OUTPUT;
+                    if (tb_win && tb_time == tb_stop) begin
+                        // Release the decided columns, resume the ACS
+                        win_base <= win_base + WIN_B;
+                        tb_win   <= 0;
+                        state    <= S_ACS;
+                    end else if (REGX || tb_time == tb_stop) begin
+                        if (tb_circ) begin
+                            // tb_state is now where the best path started,
+                            // which is where a tail-biting frame ends
+                            tb_circ      <= 0;
+                            tb_time      <= tb_last;
+                            surv_rd_time <= tb_last;
+                            tb_lone      <= tb_odd;
+                        end else if (PP) begin
+                            // Frames no longer than the tail carry no data bits
+                            ob_full[dec_slot]  <= 1;
+                            ob_total[dec_slot] <= frame_bits;
+                            dec_sel            <= dec_nx;
+                            state              <= S_IDLE;
+                        end else if (OUT_OVL) begin
+                            state          <= S_OUTPUT;
+                        end else begin
+                            out_total      <= frame_bits;
+                            out_byte_pos   <= 0;
+                            out_byte_valid <= 0;
+                            state          <= S_OUTPUT;
+                        end
                     end else begin
                         tb_time      <= tb_time - 1;
                         surv_rd_time <= tb_time - 1;
                     end
                 end
 
-                S_OUTPUT: begin
+                S_OUTPUT: if (OUT_OVL) begin
+                    // Bytes are sent by the overlapped drain above
+                    if (!ob_left && !out_byte_valid) begin
+                        frame_done <= 1;
+                        if (start_cmd)
+                            state <= S_IDLE;
+                    end
+                end else if (OUT_STREAM) begin
+                    // Registered valid/ready: the acking edge loads the next
+                    // byte, shifting out_buf down instead of muxing it
+                    if (!out_byte_valid || read_ack) begin
+                        if (out_byte_pos < out_total) begin
+                            out_byte_reg   <= out_buf[7:0];
+                            out_buf        <= out_buf >> 8;
+                            out_byte_valid <= 1;
+                            if (out_byte_pos + 8 >= out_total)
+                                out_byte_pos <= out_total;
+                            else
+                                out_byte_pos <= out_byte_pos + 8;
+                        end else begin
+                            out_byte_valid <= 0;
+                            if (!out_byte_valid) begin
+                                frame_done <= 1;
+                                if (start_cmd)
+                                    state <= S_IDLE;
+                            end
+                        end
+                    end
+                end else begin
                     if (!out_byte_valid) begin
                         if (out_byte_pos < out_total) begin
                             for (k = 0; k < 8; k = k + 1) begin
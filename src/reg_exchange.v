@@ -0,0 +1,86 @@
+//==============================================================================
+// reg_exchange: Register-exchange survivor unit, no traceback
+//==============================================================================
+// Drop-in for survivor_mem + the S_TRACE loop. Every state keeps the decoded
+// bits of its survivor path, D columns of DW bits. A write (one trellis
+// column, the same surv_row survivor_mem takes) copies each state's history
+// from the predecessor its decision picked and puts the state's own input
+// bits in column wr_ptr:
+//
+//   DW = 1   p = {dec, s[M-1:1]}            bit wr_ptr       = s[0]
+//   DW = 2   p = {dec, s[M-1:2]} (radix-4)  bits 2wr_ptr + 1 = s[0], 2wr_ptr = s[1]
+//
+// so path, the history of rd_state, is the decoded frame in out_buf order
+// as soon as the last column is written. Columns past the frame hold
+// whatever the predecessors held. half (DW = 2) writes acs4_unit's single
+// radix-2 column for the odd last symbol of a frame: p = {dec[0], s[M-1:1]},
+// bit 2wr_ptr = s[0] and bit 2wr_ptr + 1 = 0.
+//==============================================================================
+
+`default_nettype none
+
+module reg_exchange #(
+    parameter K  = 5,
+    parameter M  = K - 1,
+    parameter S  = (1 << M),
+    parameter D  = 32,          // columns (trellis steps, pairs with DW = 2)
+    parameter DW = 1            // decision bits per state (2 for radix-4)
+) (
+    input  wire                 clk,
+    input  wire                 rst,
+    input  wire                 init_frame,
+    input  wire                 wr_en,
+    input  wire [S*DW-1:0]      surv_row,
+    input  wire                 half,       // DW = 2: radix-2 column
+
+    input  wire [M-1:0]         rd_state,
+    output wire [D*DW-1:0]      path
+);
+
+  localparam PW = D * DW;
+
+  reg  [$clog2(D)-1:0] wr_ptr;
+  wire [S*PW-1:0]      hist;
+
+  always @(posedge clk) begin
+    if (rst || init_frame)
+      wr_ptr <= {$clog2(D){1'b0}};
+    else if (wr_en)
+      wr_ptr <= (wr_ptr == D - 1) ? {$clog2(D){1'b0}} : wr_ptr + 1;
+  end
+
+  genvar s;
+  generate
+    for (s = 0; s < S; s = s + 1) begin : st
+      // Input bits that lead into s, in out_buf order
+      localparam [DW-1:0] OWN = (DW == 2) ? (((s & 1) << 1) | ((s >> 1) & 1)) : (s & 1);
+
+      localparam [DW-1:0] OWN1 = s & 1;
+
+      wire          lone = (DW == 2) && half;
+      wire [DW-1:0] dec  = surv_row[s*DW +: DW];
+      wire [M-1:0]  pred = lone ? (s >> 1) | (dec[0] << (M - 1))
+                                : (s >> DW) | (dec << (M - DW));
+      wire [PW-1:0] from = hist[pred*PW +: PW];
+
+      reg  [PW-1:0] h;
+      integer j;
+
+      always @(posedge clk) begin
+        if (rst) begin
+          h <= {PW{1'b0}};
+        end else if (wr_en && !init_frame) begin
+          for (j = 0; j < D; j = j + 1)
+            h[j*DW +: DW] <= (j != wr_ptr) ? from[j*DW +: DW] : lone ? OWN1 : OWN;
+        end
+      end
+
+      assign hist[s*PW +: PW] = h;
+    end
+  endgenerate
+
+  assign path = hist[rd_state*PW +: PW];
+
+endmodule
+
+`default_nettype wire
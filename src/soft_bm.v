@@ -0,0 +1,28 @@
+//==============================================================================
+// soft_bm: Soft-decision branch metric of one 2-bit expected symbol
+//==============================================================================
+// a carries two Q-bit quantised samples, a[2Q-1:Q] for b[1] (G0) and
+// a[Q-1:0] for b[0] (G1); 0 is a confident 0, 2^Q - 1 a confident 1. Each
+// sample costs its distance from the expected bit, q for a 0 and
+// 2^Q - 1 - q (= ~q) for a 1, so c runs 0 .. 2(2^Q - 1) and fits Q + 1 bits.
+// With Q = 1 this is ham2.
+//==============================================================================
+
+`default_nettype none
+
+module soft_bm #(
+    parameter Q = 3
+) (
+    input  wire [2*Q-1:0] a,
+    input  wire [1:0]     b,
+    output wire [Q:0]     c
+);
+
+    wire [Q-1:0] d1 = b[1] ? ~a[2*Q-1:Q] : a[2*Q-1:Q];
+    wire [Q-1:0] d0 = b[0] ? ~a[Q-1:0]   : a[Q-1:0];
+
+    assign c = {1'b0, d1} + {1'b0, d0};
+
+endmodule
+
+`default_nettype wire
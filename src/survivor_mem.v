@@ -3,29 +3,30 @@ module survivor_mem #(
     parameter M = K - 1,
     parameter S = (1 << M),
     parameter Wm = 8,
-    parameter D = 10
+    parameter D = 10,
+    parameter DW = 1          // decision bits per state (2 for radix-4)
 ) (
     input wire clk,
     input wire rst,
     input wire init_frame,
     input wire wr_en,
-    input wire [S-1:0] surv_row,
+    input wire [S*DW-1:0] surv_row,
 
     output reg [$clog2(D)-1:0] wr_ptr,
 
     input wire [$clog2(S)-1:0] rd_state,
     input wire [$clog2(D)-1:0] rd_time,
 
-    output wire surv_bit
+    output wire [DW-1:0] surv_bit
 );
 
-  reg [S-1:0] mem [0:D-1];
+  reg [S*DW-1:0] mem [0:D-1];
   integer j;
 
   always @(posedge clk) begin
     if (rst) begin
       wr_ptr <= {$clog2(D){1'b0}};
-      for (j = 0; j < D; j = j + 1) mem[j] <= {S{1'b0}};
+      for (j = 0; j < D; j = j + 1) mem[j] <= {(S*DW){1'b0}};
     end else if (init_frame) begin
       wr_ptr <= {$clog2(D){1'b0}};
     end else if (wr_en) begin
@@ -38,6 +39,6 @@ module survivor_mem #(
     end
   end
 
-  assign surv_bit = mem[rd_time][rd_state];
+  assign surv_bit = mem[rd_time][rd_state*DW +: DW];
 
 endmodule
\ No newline at end of file
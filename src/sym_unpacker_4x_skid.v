@@ -0,0 +1,79 @@
+//==============================================================================
+// sym_unpacker_4x_skid: Full-throughput byte to 2-bit symbol unpacker
+//==============================================================================
+// Same ports and symbol order as sym_unpacker_4x (symbol 0 = bits [1:0] up to
+// symbol 3 = bits [7:6]), but sustains one symbol per cycle. sym_unpacker_4x
+// holds in_ready low while a byte drains and takes the next one only after
+// the last symbol has left, so every byte costs 5 cycles.
+//
+// Here the byte being emitted sits in byte_buf and the next one can already
+// be accepted into a one-byte skid register. On the edge the last symbol of
+// byte_buf is consumed the skid byte moves up (or, with the skid empty, the
+// byte on in_byte is taken directly), so rx_sym_valid never drops while
+// bytes are available. in_ready is the registered "skid empty" flag and does
+// not depend on rx_sym_ready, so no ready path runs through the unpacker.
+// rx_sym is a 4:1 mux of byte_buf; it holds while rx_sym_ready is low.
+//==============================================================================
+
+`default_nettype none
+
+module sym_unpacker_4x_skid (
+    input  wire       clk,
+    input  wire       rst,
+
+    input  wire       in_valid,
+    output wire       in_ready,
+    input  wire [7:0] in_byte,
+
+    output wire       rx_sym_valid,
+    input  wire       rx_sym_ready,
+    output wire [1:0] rx_sym
+);
+
+    reg [7:0] byte_buf;     // byte being emitted
+    reg [1:0] sym_count;    // symbol of byte_buf on rx_sym
+    reg       has_data;
+    reg [7:0] skid_buf;     // next byte, taken while byte_buf drains
+    reg       skid_valid;
+
+    wire take = in_valid && in_ready;
+    wire step = has_data && rx_sym_ready;
+    // byte_buf is free on this edge: empty, or its last symbol leaves
+    wire load = !has_data || (step && sym_count == 2'b11);
+
+    always @(posedge clk) begin
+        if (rst) begin
+            byte_buf   <= 8'b0;
+            sym_count  <= 2'b00;
+            has_data   <= 1'b0;
+            skid_buf   <= 8'b0;
+            skid_valid <= 1'b0;
+        end else if (load) begin
+            sym_count <= 2'b00;
+            if (skid_valid) begin
+                // in_ready is low, so nothing is taken this cycle
+                byte_buf   <= skid_buf;
+                has_data   <= 1'b1;
+                skid_valid <= 1'b0;
+            end else begin
+                if (take)
+                    byte_buf <= in_byte;
+                has_data <= take;
+            end
+        end else begin
+            if (step)
+                sym_count <= sym_count + 1'b1;
+            if (take) begin
+                skid_buf   <= in_byte;
+                skid_valid <= 1'b1;
+            end
+        end
+    end
+
+    assign in_ready     = !skid_valid;
+    assign rx_sym_valid = has_data;
+    assign rx_sym       = byte_buf[2*sym_count +: 2];
+
+endmodule
+
+`default_nettype wire
@@ -0,0 +1,74 @@
+//==============================================================================
+// sync_fifo: Single-clock FIFO with almost-full / almost-empty flags
+//==============================================================================
+// D entries of W bits in registers, D a power of two (at least 2). dout is
+// the head entry, valid while empty is low; pop removes it on the clock
+// edge. A push while full and a pop while empty are ignored, so callers may
+// tie push / pop to their own valid and ready without gating them. A push
+// and a pop on the same edge both take effect (unless full / empty).
+//
+// afull is high from AFULL entries up, aempty up to AEMPTY entries; by
+// default a quarter of the depth from either end. All flags are registered
+// counts compared combinationally, so they change on the edge that changes
+// the fill level, like empty / full. level is the fill count itself, for
+// callers that need a threshold of their own.
+//==============================================================================
+
+`default_nettype none
+
+module sync_fifo #(
+    parameter W      = 8,
+    parameter D      = 4,
+    parameter AFULL  = D - D / 4,
+    parameter AEMPTY = D / 4,
+    parameter AW     = $clog2(D)
+) (
+    input  wire         clk,
+    input  wire         rst,
+    input  wire         push,
+    input  wire [W-1:0] din,
+    input  wire         pop,
+    output wire [W-1:0] dout,
+    output wire         empty,
+    output wire         full,
+    output wire         afull,
+    output wire         aempty,
+    output wire [AW:0]  level
+);
+
+    reg [W-1:0] mem [0:D-1];
+    reg [AW-1:0] wr_ptr, rd_ptr;
+    reg [AW:0]   count;
+
+    wire do_push = push && !full;
+    wire do_pop  = pop && !empty;
+
+    always @(posedge clk) begin
+        if (rst) begin
+            wr_ptr <= 0;
+            rd_ptr <= 0;
+            count  <= 0;
+        end else begin
+            if (do_push) begin
+                mem[wr_ptr] <= din;
+                wr_ptr      <= wr_ptr + 1'b1;
+            end
+            if (do_pop)
+                rd_ptr <= rd_ptr + 1'b1;
+            if (do_push && !do_pop)
+                count <= count + 1'b1;
+            else if (do_pop && !do_push)
+                count <= count - 1'b1;
+        end
+    end
+
+    assign dout   = mem[rd_ptr];
+    assign empty  = (count == 0);
+    assign full   = (count == D);
+    assign afull  = (count >= AFULL);
+    assign aempty = (count <= AEMPTY);
+    assign level  = count;
+
+endmodule
+
+`default_nettype wire
@@ -1,13 +1,15 @@
 // uart_conv_encoder.v
 // UART-interfaced convolutional encoder
 // Receives bytes via UART, unpacks to symbols, encodes, packs bits back to bytes
+// PUNCT = 1 / 2 punctures the output to rate 2/3 / 3/4 (c-tests/punct.h)
 
 `timescale 1ns/1ps
 
 module uart_conv_encoder #(
     parameter K = 3,
     parameter G0_OCT = 8'o7,
-    parameter G1_OCT = 8'o5
+    parameter G1_OCT = 8'o5,
+    parameter PUNCT = 0
 )(
     input wire clk,
     input wire rst,
@@ -33,12 +35,13 @@ module uart_conv_encoder #(
     wire encoder_valid;
     wire encoder_ready;
     wire [1:0] encoder_sym;
+    wire [1:0] encoder_keep;
     
     wire packer_bit;
     
     // Symbol unpacker: converts input bytes to 2-bit symbols
     // Each byte contains 4 symbols (8 bits / 2 bits per symbol)
-    sym_unpacker_4x unpacker (
+    sym_unpacker_4x_skid unpacker (
         .clk(clk),
         .rst(rst),
         .in_valid(in_valid),
@@ -95,7 +98,8 @@ module uart_conv_encoder #(
     conv_encoder_1_2 #(
         .K(K),
         .G0_OCT(G0_OCT),
-        .G1_OCT(G1_OCT)
+        .G1_OCT(G1_OCT),
+        .PUNCT(PUNCT)
     ) encoder (
         .clk(clk),
         .rst(rst),
@@ -104,13 +108,16 @@ module uart_conv_encoder #(
         .in_valid(encoder_in_valid),
         .in_bit(encoder_in_bit),
         .out_valid(encoder_valid),
-        .out_sym(encoder_sym)
+        .out_sym(encoder_sym),
+        .out_keep(encoder_keep)
     );
     
     // The encoder outputs 2-bit symbols, but the bit packer expects single bits
-    // We need to serialize the encoder output
+    // We need to serialize the encoder output. Punctured bits still take
+    // their slot but get no packer_bit_valid pulse
     reg enc_sym_waiting;
     reg [1:0] enc_sym_buf;
+    reg [1:0] enc_keep_buf;
     reg enc_bit_select;
     reg packer_bit_valid;
     
@@ -122,19 +129,22 @@ module uart_conv_encoder #(
             enc_sym_waiting <= 1'b0;
             enc_bit_select <= 1'b0;
             enc_sym_buf <= 2'b00;
+            enc_keep_buf <= 2'b11;
             packer_bit_valid <= 1'b0;
         end else begin
             if (encoder_valid && encoder_ready) begin
                 // New encoded symbol received
                 enc_sym_buf <= encoder_sym;
+                enc_keep_buf <= encoder_keep;
                 enc_sym_waiting <= 1'b1;
                 enc_bit_select <= 1'b0;
                 packer_bit_valid <= 1'b0;
             end else if (enc_sym_waiting) begin
                 // Try to send bit to packer
                 if (!out_valid) begin
-                    // Packer can accept, pulse valid
-                    packer_bit_valid <= 1'b1;
+                    // Packer can accept, pulse valid unless the bit
+                    // presented next (after the select flips) is punctured
+                    packer_bit_valid <= enc_bit_select ? enc_keep_buf[0] : enc_keep_buf[1];
                     if (!enc_bit_select) begin
                         // Move to second bit next cycle
                         enc_bit_select <= 1'b1;
@@ -236,6 +236,7 @@ module tt_um_viterbi_core #(
         .clk        (clk),
         .rst        (rst),
         .init_frame (init_frame_pulse),
+        .init_flat  (1'b0),
         .rd_idx0    (p0),
         .rd_idx1    (p1),
         .wr_en      (pm_wr_en),
@@ -0,0 +1,402 @@
+//==============================================================================
+// viterbi_stream: Continuous (sliding-window) decoder for the UART interface
+//==============================================================================
+// Decodes an unbounded symbol stream with a fixed traceback depth D, matching
+// viterbi_decode_streaming() in c-tests/viterbi_golden.c bit for bit:
+//
+//   - one trellis step per symbol (serial ACS, one state per cycle, the same
+//     expected_bits / branch_metric / acs_core / pm_bank datapath as the
+//     frame mode), survivor columns in a D-deep survivor_mem ring
+//   - after each step, a D-step traceback from the best state of that step;
+//     the last survivor bit read is the decoded bit for the step D-1 back
+//   - the first D-1+M decoded bits precede the first input bit and are
+//     dropped, so the output stream starts with the first encoded bit
+//
+// The traceback of step t overlaps the ACS sweep of step t+1; step t+1 only
+// commits its survivor column once that traceback is done, so the ring never
+// overwrites a column still being read. A symbol costs max(S + 2, D + 3)
+// cycles once the pipeline is full.
+//
+// TB_BLOCK = B > 1 traces back only after every B-th step, D + B - 1 steps
+// from its best state, and keeps the last B bits read: one pass decides B
+// bits, each at depth D or more (viterbi_decode_streaming_block()). The
+// ring grows to D + 2B - 2 columns so the B - 1 steps in between commit
+// while the pass reads, and the decided block drains to the byte packer
+// while the next pass runs. B symbols then cost max(B (S + 2), D + B + 2)
+// cycles, so B = 2 (K = 5) or B = 8 (K = 3) keeps up with the ACS sweep at
+// D = 32. The output stream is the same bit positions as with B = 1; send
+// D + B - 2 zero symbols after the code tail to flush it.
+//
+// Path metrics never wrap: when every new metric has its MSB set, the next
+// step reads them with the MSB cleared (a uniform shift by 2^(PM_WIDTH-1)).
+// PM_MODULO = 1 lets them wrap instead and compares them modulo 2^PM_WIDTH
+// (pm_lt), which needs no shift at all.
+//
+// The host sends padded symbol bytes whenever in_ready is high and collects
+// output bytes (bit i = i-th decoded bit) with out_ack. To flush the last
+// bits, send D-1 zero symbols after the code tail. restart re-initialises
+// the trellis and drops any unread symbols and a partial output byte; it is
+// taken only while the engine is idle and no output byte is pending.
+//==============================================================================
+
+`default_nettype none
+
+module viterbi_stream #(
+    parameter K        = 5,
+    parameter G0_OCT   = 'o23,
+    parameter G1_OCT   = 'o35,
+    parameter D        = 32,        // traceback depth
+    parameter TB_BLOCK = 1,         // bits decided per traceback pass
+    parameter PM_WIDTH = 8,
+    parameter PM_MODULO = 0
+) (
+    input  wire       clk,
+    input  wire       rst,
+    input  wire       restart,
+
+    input  wire       in_valid,
+    output wire       in_ready,
+    input  wire [7:0] in_byte,
+
+    output wire       out_valid,
+    input  wire       out_ack,
+    output wire [7:0] out_byte,
+
+    output wire       busy
+);
+
+    localparam M          = K - 1;
+    localparam NUM_STATES = 1 << M;
+    localparam Wb         = 2;
+    localparam B          = TB_BLOCK;
+    localparam RING       = D + 2 * B - 2;    // survivor ring columns
+    localparam TW         = (RING > 1) ? $clog2(RING) : 1;
+    localparam CW         = $clog2(D + B - 1);
+    localparam BW         = (B > 1) ? $clog2(B) : 1;
+    localparam EW         = $clog2(B + 1);
+    localparam WARM       = D - 1 + M;
+    localparam WW         = $clog2(WARM + 1);
+
+    // ACS side
+    localparam [2:0] A_INIT0  = 3'd0,
+                     A_INIT1  = 3'd1,
+                     A_INIT2  = 3'd2,
+                     A_IDLE   = 3'd3,
+                     A_SWEEP  = 3'd4,
+                     A_COMMIT = 3'd5;
+
+    // Traceback side
+    localparam [1:0] T_IDLE = 2'd0,
+                     T_WAIT = 2'd1,
+                     T_RUN  = 2'd2,
+                     T_EMIT = 2'd3;
+
+    reg [2:0]          a_state;
+    reg [1:0]          t_state;
+
+    reg [1:0]          rx_sym_q;
+    reg [M-1:0]        sweep_idx;
+    reg [NUM_STATES-1:0] surv_row;
+    reg [PM_WIDTH-1:0] best_metric;
+    reg [M-1:0]        best_state;
+    reg                msb_all;      // every new metric so far has its MSB set
+    reg                pm_norm;      // clear MSBs on reads this step
+
+    reg                pm_init_frame;
+    reg                pm_swap_banks;
+    reg                pm_wr_en;
+    reg [M-1:0]        pm_wr_idx;
+    reg [PM_WIDTH-1:0] pm_wr_data;
+    reg                surv_init_frame;
+    reg                surv_wr_en;
+
+    reg [TW-1:0]       tb_time;
+    reg [M-1:0]        tb_state;
+    reg [CW-1:0]       tb_cnt;
+    reg [BW-1:0]       blk_pos;      // step within the current block
+    reg [B-1:0]        blk;          // bits of this pass, oldest at B-1
+    reg [B-1:0]        em_buf;       // block draining to the packer
+    reg [EW-1:0]       em_cnt;
+    reg                dec_bit;
+    reg                dec_valid;
+    reg [WW-1:0]       warm;
+
+    // =========================================================================
+    // Byte in / symbols out, decoded bits in / bytes out
+    // =========================================================================
+    wire       sym_valid;
+    wire [1:0] sym;
+    wire       sym_ready = (a_state == A_IDLE);
+    wire       unpack_ready;
+    wire       restart_go = restart && a_state == A_IDLE && t_state == T_IDLE && em_cnt == 0 &&
+                            !out_valid;
+
+    // uio is shared: no input byte is taken while an output byte is driven
+    assign in_ready = unpack_ready && !out_valid;
+
+    sym_unpacker_4x_skid unpack (
+        .clk          (clk),
+        .rst          (rst || restart_go),
+        .in_valid     (in_valid && !out_valid),
+        .in_ready     (unpack_ready),
+        .in_byte      (in_byte),
+        .rx_sym_valid (sym_valid),
+        .rx_sym_ready (sym_ready),
+        .rx_sym       (sym)
+    );
+
+    bit_packer_8x pack (
+        .clk           (clk),
+        .rst           (rst || restart_go),
+        .dec_bit_valid (dec_valid),
+        .dec_bit       (dec_bit),
+        .out_valid     (out_valid),
+        .out_ready     (out_ack),
+        .out_byte      (out_byte)
+    );
+
+    assign busy = (a_state != A_IDLE) || (t_state != T_IDLE) || (em_cnt != 0);
+
+    // =========================================================================
+    // ACS datapath (serial, as g_acs_serial in project.v)
+    // =========================================================================
+    wire [M-1:0] pred0 = sweep_idx >> 1;
+    wire [M-1:0] pred1 = (sweep_idx >> 1) | (1 << (M - 1));
+
+    wire [1:0]          exp0, exp1;
+    wire [Wb-1:0]       bm0, bm1;
+    wire [PM_WIDTH-1:0] pm_rd0, pm_rd1;
+    wire [PM_WIDTH-1:0] acs_pm;
+    wire                acs_surv;
+
+    localparam [PM_WIDTH-1:0] PM_LOW = {1'b0, {(PM_WIDTH-1){1'b1}}};
+    wire [PM_WIDTH-1:0] pm_in0 = pm_norm ? (pm_rd0 & PM_LOW) : pm_rd0;
+    wire [PM_WIDTH-1:0] pm_in1 = pm_norm ? (pm_rd1 & PM_LOW) : pm_rd1;
+
+    expected_bits #(.K(K), .G0_OCT(G0_OCT), .G1_OCT(G1_OCT)) eb0 (
+        .pred (pred0), .b (sweep_idx[0]), .expected (exp0)
+    );
+
+    expected_bits #(.K(K), .G0_OCT(G0_OCT), .G1_OCT(G1_OCT)) eb1 (
+        .pred (pred1), .b (sweep_idx[0]), .expected (exp1)
+    );
+
+    branch_metric #(.Wb(Wb)) bm_inst (
+        .rx_sym   (rx_sym_q),
+        .exp_sym0 (exp0),
+        .exp_sym1 (exp1),
+        .bm0      (bm0),
+        .bm1      (bm1)
+    );
+
+    acs_core #(.Wm(PM_WIDTH), .Wb(Wb), .MODULO(PM_MODULO)) acs_inst (
+        .pm0    (pm_in0),
+        .pm1    (pm_in1),
+        .bm0    (bm0),
+        .bm1    (bm1),
+        .pm_out (acs_pm),
+        .surv   (acs_surv)
+    );
+
+    wire pm_prev_A;
+
+    pm_bank #(.K(K), .Wm(PM_WIDTH), .MODULO(PM_MODULO)) pm_inst (
+        .clk        (clk),
+        .rst        (rst),
+        .init_frame (pm_init_frame),
+        .init_flat  (1'b0),
+        .rd_idx0    (pred0),
+        .rd_idx1    (pred1),
+        .wr_en      (pm_wr_en),
+        .wr_idx     (pm_wr_idx),
+        .wr_pm      (pm_wr_data),
+        .swap_banks (pm_swap_banks),
+        .rd_pm0     (pm_rd0),
+        .rd_pm1     (pm_rd1),
+        .prev_A     (pm_prev_A)
+    );
+
+    wire [TW-1:0] surv_wr_ptr;
+    wire          surv_bit;
+
+    survivor_mem #(.K(K), .Wm(PM_WIDTH), .D(RING)) surv_inst (
+        .clk        (clk),
+        .rst        (rst),
+        .init_frame (surv_init_frame),
+        .wr_en      (surv_wr_en),
+        .surv_row   (surv_row),
+        .wr_ptr     (surv_wr_ptr),
+        .rd_state   (tb_state),
+        .rd_time    (tb_time),
+        .surv_bit   (surv_bit)
+    );
+
+    wire best_lt;
+    pm_lt #(.Wm(PM_WIDTH), .MODULO(PM_MODULO)) best_cmp (
+        .a  (acs_pm),
+        .b  (best_metric),
+        .lt (best_lt)
+    );
+
+    wire _unused = &{pm_prev_A, 1'b0};
+
+    // A pass starts with the last step of each block; the others commit
+    // without waiting, into columns the running pass does not read
+    wire pass_due = (B == 1) || (blk_pos == B - 1);
+
+    // =========================================================================
+    // FSMs
+    // =========================================================================
+    always @(posedge clk) begin
+        if (rst) begin
+            a_state         <= A_INIT0;
+            t_state         <= T_IDLE;
+            rx_sym_q        <= 0;
+            sweep_idx       <= 0;
+            surv_row        <= 0;
+            best_metric     <= 0;
+            best_state      <= 0;
+            msb_all         <= 0;
+            pm_norm         <= 0;
+            pm_init_frame   <= 0;
+            pm_swap_banks   <= 0;
+            pm_wr_en        <= 0;
+            pm_wr_idx       <= 0;
+            pm_wr_data      <= 0;
+            surv_init_frame <= 0;
+            surv_wr_en      <= 0;
+            tb_time         <= 0;
+            tb_state        <= 0;
+            tb_cnt          <= 0;
+            blk_pos         <= 0;
+            blk             <= 0;
+            em_buf          <= 0;
+            em_cnt          <= 0;
+            dec_bit         <= 0;
+            dec_valid       <= 0;
+            warm            <= 0;
+        end else begin
+            pm_init_frame   <= 0;
+            pm_swap_banks   <= 0;
+            pm_wr_en        <= 0;
+            surv_init_frame <= 0;
+            surv_wr_en      <= 0;
+            dec_valid       <= 0;
+
+            case (a_state)
+                A_INIT0: begin
+                    pm_init_frame   <= 1;
+                    surv_init_frame <= 1;
+                    pm_norm         <= 0;
+                    warm            <= 0;
+                    blk_pos         <= 0;
+                    a_state         <= A_INIT1;
+                end
+                A_INIT1: begin
+                    pm_swap_banks <= 1;
+                    a_state       <= A_INIT2;
+                end
+                A_INIT2: begin
+                    a_state <= A_IDLE;
+                end
+
+                A_IDLE: begin
+                    if (restart_go) begin
+                        a_state <= A_INIT0;
+                    end else if (sym_valid) begin
+                        rx_sym_q  <= sym;
+                        sweep_idx <= 0;
+                        a_state   <= A_SWEEP;
+                    end
+                end
+
+                A_SWEEP: begin
+                    pm_wr_en   <= 1;
+                    pm_wr_idx  <= sweep_idx;
+                    pm_wr_data <= acs_pm;
+                    surv_row[sweep_idx] <= acs_surv;
+
+                    // argmin, first state wins ties
+                    if (sweep_idx == 0 || best_lt) begin
+                        best_metric <= acs_pm;
+                        best_state  <= sweep_idx;
+                    end
+                    msb_all <= (sweep_idx == 0 || msb_all) && acs_pm[PM_WIDTH-1];
+
+                    if (sweep_idx == NUM_STATES - 1)
+                        a_state <= A_COMMIT;
+                    else
+                        sweep_idx <= sweep_idx + 1;
+                end
+
+                A_COMMIT: begin
+                    // Wait for the previous traceback to release the ring
+                    if (!pass_due || t_state == T_IDLE) begin
+                        surv_wr_en    <= 1;
+                        pm_swap_banks <= 1;
+                        pm_norm       <= !PM_MODULO && msb_all;
+                        blk_pos       <= pass_due ? 0 : blk_pos + 1;
+                        a_state       <= A_IDLE;
+                        if (pass_due) begin
+                            tb_time  <= surv_wr_ptr;
+                            tb_state <= best_state;
+                            t_state  <= T_WAIT;
+                        end
+                    end
+                end
+
+                default: a_state <= A_INIT0;
+            endcase
+
+            case (t_state)
+                T_WAIT: begin
+                    // survivor column is written this edge
+                    tb_cnt  <= 0;
+                    t_state <= T_RUN;
+                end
+
+                T_RUN: begin
+                    tb_state <= {surv_bit, tb_state[M-1:1]};
+                    tb_time  <= (tb_time == 0) ? RING - 1 : tb_time - 1;
+                    // The last B bits read are decided, newest first
+                    if (tb_cnt >= D - 1)
+                        blk <= (blk >> 1) | (surv_bit << (B - 1));
+                    if (tb_cnt == D + B - 2)
+                        t_state <= T_EMIT;
+                    else
+                        tb_cnt <= tb_cnt + 1;
+                end
+
+                T_EMIT: begin
+                    // Hand the block over once the previous one has drained
+                    if (em_cnt == 0) begin
+                        em_buf  <= blk;
+                        em_cnt  <= B;
+                        t_state <= T_IDLE;
+                    end
+                end
+
+                default: ;
+            endcase
+
+            // Oldest bit first; warm-up bits are dropped, and the packer
+            // takes a bit only while no byte is waiting and the previous
+            // bit has landed
+            if (em_cnt != 0) begin
+                if (warm != WARM) begin
+                    warm   <= warm + 1;
+                    em_buf <= em_buf << 1;
+                    em_cnt <= em_cnt - 1;
+                end else if (!out_valid && !dec_valid) begin
+                    dec_bit   <= em_buf[B-1];
+                    dec_valid <= 1;
+                    em_buf    <= em_buf << 1;
+                    em_cnt    <= em_cnt - 1;
+                end
+            end
+        end
+    end
+
+endmodule
+
+`default_nettype wire
@@ -0,0 +1,200 @@
+#!/usr/bin/env python3
+"""Estimated register and datapath counts of tt_um_ashvin_viterbi per
+ACS_PAR / RADIX.
+
+Hand counts from the RTL structure (project.v, acs_unit.v, pm_bank*.v,
+survivor_mem.v), not from a netlist: storage follows the RTL, control
+registers and the traceback / output logic (identical in every ACS mode) are
+left out, and synthesis may share or drop logic. Use it to compare
+configurations before running `make -C synth`, whose yosys reports are the
+synthesized numbers.
+
+    python3 resources.py                 # K = 5 and 7, every ACS_PAR, ACS_PIPE, radix-4
+    python3 resources.py -k 7 -f 32 -w 8  # -w 0 (default): project.v's PM width
+    python3 resources.py --modulo         # PM_MODULO = 1 widths
+    python3 resources.py -f 256 -s 32     # SURV_DEPTH = 32 survivor ring
+    python3 resources.py --survivor       # survivor_mem vs TB_PAIR vs REG_EXCHANGE, K = 3, 5, 7
+    python3 resources.py --synth reports  # estimates next to the yosys logs there
+"""
+
+import argparse
+import os
+import re
+
+
+def pm_width(k, radix=2, max_frame=32, modulo=False):
+    """PM_WIDTH = 0, hard symbols: clog2(2M + BM + 1) + 2 with PM_MODULO = 1,
+    clog2(2(MAX_FRAME + M) + BM + 1) + 1 with plain compares."""
+    bm = 4 if radix == 4 else 2
+    if modulo:
+        return (2 * (k - 1) + bm).bit_length() + 2
+    return (2 * (max_frame + k - 1) + bm).bit_length() + 1
+
+
+def resources(k, acs_par, max_frame=32, wm=0, radix=2, surv_depth=0, pipe=False,
+              modulo=False):
+    m = k - 1
+    s = 1 << m
+    wm = wm or pm_width(k, radix, max_frame, modulo)
+    # survivor steps stored: the whole frame, or the SURV_DEPTH ring
+    surv = min(surv_depth, max_frame) if surv_depth else max_frame
+    if radix == 4:
+        # acs4_unit: 4 three-operand path sums and 6 compares per state,
+        # 2-bit decisions in half as many survivor columns
+        return {"cycles_per_symbol": 0.5, "pm_flops": s * wm,
+                "surv_flops": s * surv, "stage_flops": 0,
+                "adders": 8 * s, "comparators": 6 * s, "pm_read_mux_bits": 0}
+    full = acs_par == s // 2
+    states = 1 if acs_par == 0 else 2 * acs_par      # states per ACS cycle
+    groups = s // states
+    r = {}
+    r["pm_flops"] = s * wm if full else 2 * s * wm
+    r["surv_flops"] = s * surv
+    # pm_wr_data / surv_row staging; the fully parallel mode writes directly
+    r["stage_flops"] = 0 if full else states * wm + s
+    r["adders"] = 2 * states                       # wm-bit, pm + bm
+    r["comparators"] = states                      # wm-bit
+    # PM read: two ports of states/2 (or 1) metrics, each a (2*groups):1 mux
+    ports = 1 if acs_par == 0 else acs_par
+    r["pm_read_mux_bits"] = 0 if full else 2 * ports * wm * (2 * groups - 1)
+    r["cycles_per_symbol"] = 1 if full else groups + 1
+    if pipe and acs_par == 0:
+        # acs_pipe: registered metric reads and branch metrics, then the
+        # registered result (the write port), surv_row; the write-port
+        # forward adds a 2:1 mux per read bit, and there is no commit cycle
+        r["stage_flops"] = 2 * wm + 2 * 2 + wm + 1 + s
+        r["pm_read_mux_bits"] += 2 * wm
+        r["cycles_per_symbol"] = groups
+    return r
+
+
+def survivor(k, max_frame=32, radix=2, regx=False, pair=False):
+    """Estimated survivor storage, its muxes and S_TRACE cycles for one frame.
+
+    Hand counts of the structure below, not synthesized: yosys may share
+    mux levels or map the decision store to other cells.
+
+    survivor_mem: one decision bit per state and step, read back one at a
+    time through an (S * steps):1 mux, one traceback cycle per column.
+    TB_PAIR (radix-2): the same bits read two at a time, plus the S-bit row
+    register holding column 2j, S 2:1 muxes composing each pair on write and
+    an S:1 mux for the unpaired last column; two columns per cycle.
+    reg_exchange: one decoded bit per state and step, each state's history
+    copied from one of 2 (radix-2) or 4 (radix-4) predecessors every column,
+    plus the end-state read mux (S:1, only used for TRUNC frames); S_TRACE is
+    a single cycle.
+    """
+    s = 1 << (k - 1)
+    bits = s * max_frame
+    cols = max_frame // 2 if radix == 4 else max_frame
+    if pair and radix == 2 and not regx:
+        return {"flops": bits + s, "mux_bits": (bits - 2) + s + (s - 1),
+                "trace_cycles": (cols + 1) // 2}
+    if not regx:
+        return {"flops": bits, "mux_bits": bits - 1, "trace_cycles": cols}
+    per_bit = 3 if radix == 4 else 1               # 2:1 muxes per 4:1 / 2:1
+    return {"flops": bits, "mux_bits": bits * per_bit + (s - 1) * max_frame,
+            "trace_cycles": 1}
+
+
+def survivor_table(ks, max_frame, radix):
+    print("Estimate: counted from the RTL structure, not synthesized (make -C synth survivor)\n")
+    print("| K | survivor | flops | 2:1 mux bits | S_TRACE cycles |")
+    print("|---|----------|------:|-------------:|---------------:|")
+    for k in ks:
+        for name, regx, pair in (("survivor_mem", False, False), ("TB_PAIR", False, True),
+                                 ("reg_exchange", True, False)):
+            if pair and radix == 4:
+                continue
+            r = survivor(k, max_frame, radix, regx, pair)
+            print("| %d | %s | %d | %d | %d |" % (k, name, r["flops"], r["mux_bits"],
+                                                r["trace_cycles"]))
+
+
+def synth_stat(path):
+    """Cells, flops and area (None without the liberty) from a yosys log
+    written by synth/Makefile, the same fields as its summary target."""
+    cells = flops = area = None
+    with open(path) as f:
+        for line in f:
+            m = re.search(r"Number of cells:\s*(\d+)", line)
+            if m:
+                cells = int(m.group(1))
+                flops = 0
+            elif flops is not None and re.search(r"\$_S?DFF|dfxtp|dfrtp|dfstp|edfxtp", line):
+                flops += int(line.split()[-1])
+            m = re.search(r"Chip area.*?([\d.]+)\s*$", line)
+            if m:
+                area = float(m.group(1))
+    return cells, flops, area
+
+
+def synth_table(ks, max_frame, reports):
+    """Estimated storage flops next to the synthesized top, for every
+    config synth/Makefile has a log of. Synthesis also counts the control
+    registers, buffers and pins the estimate leaves out."""
+    print("Storage flops estimated from the RTL; cells, flops and area from yosys\n")
+    print("| config | est. storage flops | yosys flops | yosys cells | area (um^2) |")
+    print("|--------|-------------------:|------------:|------------:|------------:|")
+    for k in ks:
+        p = 0
+        rows = []
+        while p <= 1 << (k - 2):
+            rows.append(("K%d-P%d" % (k, p), resources(k, p, max_frame)))
+            if p == 0:
+                rows.append(("K%d-P0-R2-A1" % k, resources(k, 0, max_frame, pipe=True)))
+            p = 2 * p if p else 1
+        rows.append(("K%d-P0-R4" % k, resources(k, 0, max_frame, radix=4)))
+        for name, r in rows:
+            path = os.path.join(reports, name + ".log")
+            if not os.path.exists(path):
+                continue
+            cells, flops, area = synth_stat(path)
+            est = r["pm_flops"] + r["surv_flops"] + r["stage_flops"]
+            print("| %s | %d | %s | %s | %s |" % (name, est, "-" if flops is None else flops,
+                                                 "-" if cells is None else cells,
+                                                 "-" if area is None else "%.1f" % area))
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("-k", type=int, action="append")
+    ap.add_argument("-f", "--max-frame", type=int, default=32)
+    ap.add_argument("-w", "--pm-width", type=int, default=0)
+    ap.add_argument("-s", "--surv-depth", type=int, default=0)
+    ap.add_argument("-r", "--radix", type=int, default=2)
+    ap.add_argument("--modulo", action="store_true")
+    ap.add_argument("--survivor", action="store_true")
+    ap.add_argument("--synth", metavar="DIR")
+    a = ap.parse_args()
+
+    if a.survivor:
+        survivor_table(a.k or [3, 5, 7], a.max_frame, a.radix)
+        return
+    if a.synth:
+        synth_table(a.k or [5, 7], a.max_frame, a.synth)
+        return
+
+    cols = ["cycles_per_symbol", "pm_flops", "surv_flops", "stage_flops",
+            "adders", "comparators", "pm_read_mux_bits"]
+    print("Estimate: counted from the RTL structure, not synthesized (make -C synth)\n")
+    print("| K | ACS_PAR | " + " | ".join(cols) + " |")
+    print("|---|--------:|" + "|".join("-" * (len(c) + 1) + ":" for c in cols) + "|")
+    for k in a.k or [5, 7]:
+        p = 0
+        while p <= 1 << (k - 2):
+            r = resources(k, p, a.max_frame, a.pm_width, surv_depth=a.surv_depth,
+                          modulo=a.modulo)
+            print("| %d | %d | " % (k, p) + " | ".join(str(r[c]) for c in cols) + " |")
+            if p == 0:
+                r = resources(k, 0, a.max_frame, a.pm_width, surv_depth=a.surv_depth, pipe=True,
+                              modulo=a.modulo)
+                print("| %d | 0 pipe | " % k + " | ".join(str(r[c]) for c in cols) + " |")
+            p = 2 * p if p else 1
+        r = resources(k, 0, a.max_frame, a.pm_width, radix=4, surv_depth=a.surv_depth,
+                      modulo=a.modulo)
+        print("| %d | R4 | " % k + " | ".join(str(r[c]) for c in cols) + " |")
+
+
+if __name__ == "__main__":
+    main()
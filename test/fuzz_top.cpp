@@ -0,0 +1,445 @@
+// fuzz_top.cpp
+// Differential fuzzer: Verilated tt_um_ashvin_viterbi vs the C golden model.
+//
+// Every input is one frame plus the host behaviour around it. The decoded
+// bits must equal viterbi_decode_from(symbols, L, .., 0) (viterbi_decode_trunc
+// for frames closed with TRUNC under TB_BEST_SEARCH or a SURV_DEPTH ring,
+// viterbi_decode_tailbite for frames closed
+// with TBITE under TB_TAIL_BITE, the soft / punctured versions with TB_SOFT /
+// TB_PUNCT), bit for bit, and
+// the per-frame cycle counts must equal the FSM model (c-tests/fsm_model.h)
+// driven with the same pin sequence.
+//
+// Input layout (short inputs are zero-extended):
+//   [0]    frame bytes n = 1 + (x % (MAX_BYTES + 2)), so overruns are covered
+//          (MAX_BYTES = the bytes of MAX_FRAME symbols: MAX_FRAME/4, MAX_FRAME
+//          with TB_SOFT, fewer with TB_PUNCT, see punct.h)
+//   [1]    flags: bit0 START on the same edge as the last byte (that byte is
+//                 not part of the frame), bit1 spurious START in S_IDLE before
+//                 the first byte, bit2 random ui_in pulses while BUSY,
+//                 bit3 TRUNC with the closing START, bit4 TBITE with it
+//   [2]    byte_gap = x & 7, start_gap = (x >> 3) & 7
+//   [3]    ack_delay = x & 15
+//   [4..]  n symbol bytes, then the pulse stream used by flag bit2
+//
+// Builds (see Makefile.fuzz):
+//   libFuzzer  clang++ -fsanitize=fuzzer, -DFUZZ_LIBFUZZER; crashes are
+//              minimised with -minimize_crash=1
+//   standalone g++ / afl-clang-fast++:
+//     fuzz_top FILE...               replay inputs (AFL: fuzz_top @@)
+//     fuzz_top --random N [--seed S] random inputs; failing inputs are
+//                                    minimised and written to crash-*.bin,
+//                                    and the rate is printed in frames/hour
+//     fuzz_top --regress             the fixed inputs of regress_inputs()
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Vtt_um_ashvin_viterbi.h"
+#include "verilated.h"
+
+#include "fsm_model.h"
+#include "top_driver.h"
+
+#ifndef TB_K
+#define TB_K 5
+#endif
+#ifndef TB_G0
+#define TB_G0 023
+#endif
+#ifndef TB_G1
+#define TB_G1 035
+#endif
+#ifndef TB_ACS_PAR
+#define TB_ACS_PAR 0
+#endif
+#ifndef TB_RADIX
+#define TB_RADIX 2
+#endif
+#ifndef TB_CUT
+#define TB_CUT 0
+#endif
+#ifndef TB_OUT_MODE
+#define TB_OUT_MODE 0
+#endif
+#ifndef TB_MAX_FRAME
+#define TB_MAX_FRAME 32
+#endif
+#ifndef TB_SURV_DEPTH
+#define TB_SURV_DEPTH 0
+#endif
+#ifndef TB_REGX
+#define TB_REGX 0
+#endif
+#ifndef TB_PAIR
+#define TB_PAIR 0
+#endif
+#ifndef TB_ACS_PIPE
+#define TB_ACS_PIPE 0
+#endif
+#ifndef TB_SOFT
+#define TB_SOFT 0
+#endif
+#ifndef TB_PUNCT
+#define TB_PUNCT 0
+#endif
+#ifndef TB_TAIL_BITE
+#define TB_TAIL_BITE 0
+#endif
+#ifndef TB_BEST_SEARCH
+#define TB_BEST_SEARCH 0
+#endif
+
+// C golden model, compiled into this translation unit for this code
+#define K      TB_K
+#define G0_OCT TB_G0
+#define G1_OCT TB_G1
+#include "viterbi_golden.c"
+#undef K
+
+namespace {
+
+constexpr int M = TB_K - 1;
+// Channel units (bits, or TB_SOFT-bit samples) per pattern period and byte
+constexpr int PERIOD = TB_PUNCT == 2 ? 3 : TB_PUNCT == 1 ? 2 : 1;
+constexpr int UNITS = TB_PUNCT == 2 ? 4 : TB_PUNCT == 1 ? 3 : 2;
+constexpr int UPB = TB_SOFT ? 2 : 8;
+constexpr int UW = TB_SOFT ? TB_SOFT : 1;
+constexpr int MAX_BYTES = (TB_MAX_FRAME * UNITS / PERIOD + UPB - 1) / UPB;
+constexpr uint64_t TIMEOUT = 1u << 20;
+
+struct FuzzInput {
+    int nbytes = 1;
+    bool start_with_last = false, idle_start = false, busy_noise = false, trunc = false;
+    bool tbite = false;
+    topdrv::Timing tm;
+    std::vector<uint8_t> bytes;   // symbol bytes, size nbytes
+    std::vector<uint8_t> noise;   // pulse stream for busy_noise
+};
+
+FuzzInput parse(const uint8_t *data, size_t size) {
+    auto at = [&](size_t i) -> uint8_t { return i < size ? data[i] : 0; };
+    FuzzInput in;
+    in.nbytes          = 1 + at(0) % (MAX_BYTES + 2);
+    in.start_with_last = (at(1) & 1) && in.nbytes >= 2;
+    in.idle_start      = at(1) & 2;
+    in.busy_noise      = at(1) & 4;
+    in.trunc           = at(1) & 8;
+    in.tbite           = at(1) & 16;
+    in.tm.byte_gap     = at(2) & 7;
+    in.tm.start_gap    = (at(2) >> 3) & 7;
+    in.tm.ack_delay    = at(3) & 15;
+    for (int i = 0; i < in.nbytes; ++i) in.bytes.push_back(at(4 + i));
+    for (size_t i = 4 + in.nbytes; i < size; ++i) in.noise.push_back(data[i]);
+    return in;
+}
+
+struct Outcome {
+    bool ok = false;
+    uint64_t cycles = 0, decode_cycles = 0;
+    std::vector<uint8_t> bits;
+};
+
+// ui_in bits of the START that closes the frame
+uint8_t close_ui(const FuzzInput &in) {
+    return (uint8_t)(topdrv::UI_START | (in.trunc ? topdrv::UI_TRUNC : 0) |
+                     (in.tbite ? topdrv::UI_TBITE : 0));
+}
+
+// Drive one frame with the host behaviour in `in`, on RTL or FsmModel alike.
+template <class Top>
+Outcome drive(topdrv::TopDriver<Top> &drv, const FuzzInput &in) {
+    Outcome o;
+    Top *top = drv.top();
+    drv.reset();
+    const uint64_t t0 = drv.cycle();
+
+    if (in.idle_start) drv.pulse(topdrv::UI_START);
+
+    for (int i = 0; i < in.nbytes; ++i) {
+        const bool last = i == in.nbytes - 1;
+        const uint8_t extra = (last && in.start_with_last) ? close_ui(in) : 0;
+        if (!drv.send_byte(in.bytes[i], extra)) return o;
+        if (!last || !in.start_with_last) drv.idle(in.tm.byte_gap);
+    }
+    if (!in.start_with_last) {
+        drv.idle(in.tm.start_gap);
+        drv.pulse(close_ui(in));
+    }
+    const uint64_t t_start = drv.cycle();
+
+    size_t ni = 0;
+    uint64_t waited = 0;
+    while (!(drv.status() & topdrv::UO_DONE)) {
+        const uint8_t st = drv.status();
+        if (st & topdrv::UO_OUT_VALID) {
+            if (o.bits.empty()) o.decode_cycles = drv.cycle() - t_start;
+            const uint8_t b = top->uio_out;
+            for (int k = 0; k < 8; ++k) o.bits.push_back((b >> k) & 1u);
+            drv.idle(in.tm.ack_delay);
+            drv.pulse(topdrv::UI_READ_ACK);
+            waited = 0;
+        } else {
+            // While BUSY the FSM must ignore every input pin
+            if (in.busy_noise && (st & topdrv::UO_BUSY) && !in.noise.empty()) {
+                top->ui_in = in.noise[ni++ % in.noise.size()] &
+                             (topdrv::UI_BYTE_VALID | topdrv::UI_START | topdrv::UI_READ_ACK);
+                top->uio_in = (uint8_t)ni;
+            }
+            drv.tick();
+            top->ui_in = 0;
+            if (++waited > TIMEOUT) return o;
+        }
+    }
+    drv.pulse(topdrv::UI_START);
+    if (!(drv.status() & topdrv::UO_IN_READY)) return o;  // must be back in S_IDLE
+    if (TB_OUT_MODE == 2) topdrv::reverse_byte_order(o.bits);
+    o.cycles = drv.cycle() - t0;
+    o.ok = true;
+    return o;
+}
+
+struct Harness {
+    std::unique_ptr<VerilatedContext> ctx;
+    std::unique_ptr<Vtt_um_ashvin_viterbi> top;
+    std::unique_ptr<topdrv::TopDriver<Vtt_um_ashvin_viterbi>> rtl;
+    fsmmodel::FsmModel fsm;
+    topdrv::TopDriver<fsmmodel::FsmModel> model;
+
+    static fsmmodel::Config model_config() {
+        fsmmodel::Config c;
+        c.k = TB_K;
+        c.max_frame = TB_MAX_FRAME;
+        c.acs_par = TB_ACS_PAR;
+        c.acs_pipe = TB_ACS_PIPE != 0;
+        c.radix = TB_RADIX;
+        c.cut_through = TB_CUT != 0;
+        c.out_mode = TB_OUT_MODE;
+        c.surv_depth = TB_SURV_DEPTH;
+        c.reg_exchange = TB_REGX != 0;
+        c.tb_pair = TB_PAIR != 0;
+        c.soft = TB_SOFT;
+        c.punct = TB_PUNCT;
+        c.tail_bite = TB_TAIL_BITE;
+        c.best_search = TB_BEST_SEARCH != 0;
+        return c;
+    }
+
+    Harness() : ctx(new VerilatedContext), fsm(model_config()), model(&fsm, TIMEOUT) {
+        top.reset(new Vtt_um_ashvin_viterbi(ctx.get()));
+        rtl.reset(new topdrv::TopDriver<Vtt_um_ashvin_viterbi>(top.get(), TIMEOUT));
+    }
+};
+
+Harness &harness() {
+    static Harness h;
+    return h;
+}
+
+// Returns an empty string on agreement, otherwise what went wrong.
+std::string check(const uint8_t *data, size_t size) {
+    const FuzzInput in = parse(data, size);
+    Harness &h = harness();
+    const Outcome r = drive(*h.rtl, in);
+    const Outcome m = drive(h.model, in);
+
+    // Expected frame: the symbols completed by the bytes accepted before
+    // START, capped at MAX_FRAME
+    const int captured = in.nbytes - (in.start_with_last ? 1 : 0);
+    std::vector<uint8_t> units(captured * UPB), syms(captured * UPB + 1);
+    for (int u = 0; u < (int)units.size(); ++u)
+        units[u] = (in.bytes[u / UPB] >> (UW * (u % UPB))) & ((1u << UW) - 1);
+    const int n = depuncture(units.data(), (int)units.size(), TB_PUNCT, TB_SOFT, syms.data());
+    const int L = n < TB_MAX_FRAME ? n : TB_MAX_FRAME;
+    // TRUNC and TBITE count where the top decodes such frames at all
+    const bool trunc = in.trunc && fsmmodel::best_search(Harness::model_config());
+    const bool tbite = in.tbite && fsmmodel::tail_bite(Harness::model_config());
+    const int nbits = (trunc || tbite) ? L : L > M ? L - M : 0;
+
+    uint8_t ref[TB_MAX_FRAME];
+    if (tbite && L > 0)
+        viterbi_decode_tailbite(syms.data(), L, ref, TB_TAIL_BITE, !TB_CUT, TB_SOFT, TB_PUNCT);
+    else if (!TB_REGX && TB_SURV_DEPTH != 0 && (trunc ? L > 0 : nbits > 0))
+        viterbi_decode_punct_window(syms.data(), L, ref, TB_SURV_DEPTH, trunc, TB_SOFT, TB_PUNCT);
+    else if (trunc && L > 0) viterbi_decode_punct_trunc(syms.data(), L, ref, TB_SOFT, TB_PUNCT);
+    else if (nbits > 0) viterbi_decode_punct_from(syms.data(), L, ref, 0, TB_SOFT, TB_PUNCT);
+
+    char buf[160];
+    if (!r.ok) return "RTL protocol timeout";
+    if ((int)r.bits.size() != (nbits + 7) / 8 * 8) {
+        snprintf(buf, sizeof(buf), "RTL emitted %zu bits, expected %d (L=%d)", r.bits.size(), nbits, L);
+        return buf;
+    }
+    for (int i = 0; i < nbits; ++i) {
+        if (r.bits[i] != ref[i]) {
+            snprintf(buf, sizeof(buf), "bit %d: RTL=%d C=%d (L=%d)", i, r.bits[i], ref[i], L);
+            return buf;
+        }
+    }
+    if (!m.ok || m.cycles != r.cycles || m.decode_cycles != r.decode_cycles) {
+        snprintf(buf, sizeof(buf), "cycles: RTL=%llu/%llu model=%llu/%llu",
+                 (unsigned long long)r.cycles, (unsigned long long)r.decode_cycles,
+                 (unsigned long long)m.cycles, (unsigned long long)m.decode_cycles);
+        return buf;
+    }
+    return "";
+}
+
+}  // namespace
+
+#ifdef FUZZ_LIBFUZZER
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    const std::string err = check(data, size);
+    if (!err.empty()) {
+        fprintf(stderr, "K=%d MISMATCH: %s\n", TB_K, err.c_str());
+        abort();
+    }
+    return 0;
+}
+
+#else
+
+static std::vector<uint8_t> read_file(const char *path) {
+    std::vector<uint8_t> v;
+    FILE *f = !strcmp(path, "-") ? stdin : fopen(path, "rb");
+    if (!f) { perror(path); exit(2); }
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) v.insert(v.end(), buf, buf + n);
+    if (f != stdin) fclose(f);
+    return v;
+}
+
+static bool fails(const std::vector<uint8_t> &v) {
+    return !check(v.data(), v.size()).empty();
+}
+
+// Greedy minimisation: drop bytes from the end, then clear or shrink the
+// remaining ones, as long as the input still fails.
+static std::vector<uint8_t> minimise(std::vector<uint8_t> v) {
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        for (size_t i = v.size(); i-- > 0;) {
+            std::vector<uint8_t> t = v;
+            t.erase(t.begin() + (long)i);
+            if (fails(t)) { v = t; progress = true; }
+        }
+        for (size_t i = 0; i < v.size(); ++i) {
+            for (uint8_t cand : {(uint8_t)0, (uint8_t)(v[i] >> 1), (uint8_t)(v[i] - 1)}) {
+                if (cand >= v[i]) continue;
+                std::vector<uint8_t> t = v;
+                t[i] = cand;
+                if (fails(t)) { v = t; progress = true; break; }
+            }
+        }
+    }
+    return v;
+}
+
+// Inputs for bugs the fuzzer has found, replayed by --regress. Frames no
+// longer than the tail (one hard byte at K >= 5, up to M SOFT bytes) once
+// set out_total to frame_len - M, which wrapped, and the FSM drained stale
+// out_buf bytes: without TRUNC / TBITE each must end with no output byte.
+// Closed plainly, with START on an extra last byte, after a stray START,
+// with TRUNC and with TBITE, each with a slow READ_ACK
+static std::vector<std::vector<uint8_t>> regress_inputs() {
+    std::vector<std::vector<uint8_t>> v;
+    for (int n = 1; n == 1 || n * UPB * PERIOD / UNITS <= M; ++n) {
+        for (uint8_t flags : {0, 1, 2, 8, 16}) {
+            const int nbytes = n + (flags & 1);
+            std::vector<uint8_t> in = {(uint8_t)(nbytes - 1), flags, 0x09, 0x0f};
+            for (int i = 0; i < nbytes; ++i) in.push_back((uint8_t)(0xa5 ^ (i * 0x3b)));
+            v.push_back(in);
+        }
+    }
+    return v;
+}
+
+static uint32_t xorshift32(uint32_t &s) {
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    return s;
+}
+
+int main(int argc, char **argv) {
+    uint64_t random_runs = 0;
+    uint32_t seed = 1;
+    bool regress = false;
+    std::vector<const char *> files;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--random") && i + 1 < argc) random_runs = strtoull(argv[++i], nullptr, 0);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc) seed = (uint32_t)strtoul(argv[++i], nullptr, 0);
+        else if (!strcmp(argv[i], "--regress")) regress = true;
+        else files.push_back(argv[i]);
+    }
+    if (files.empty() && !random_runs && !regress) {
+        fprintf(stderr, "usage: %s FILE... | --random N [--seed S] | --regress\n", argv[0]);
+        return 2;
+    }
+
+    int failures = 0;
+    uint64_t regress_runs = 0;
+    if (regress) {
+        for (const std::vector<uint8_t> &v : regress_inputs()) {
+            const std::string err = check(v.data(), v.size());
+            ++regress_runs;
+            if (!err.empty()) {
+                ++failures;
+                printf("FAIL regress input %llu: %s\n", (unsigned long long)regress_runs - 1,
+                       err.c_str());
+            }
+        }
+    }
+    for (const char *f : files) {
+        std::vector<uint8_t> v = read_file(f);
+        const std::string err = check(v.data(), v.size());
+        if (!err.empty()) {
+            ++failures;
+            printf("FAIL %s: %s\n", f, err.c_str());
+            if (getenv("AFL_FUZZER") || getenv("__AFL_SHM_ID")) abort();
+        }
+    }
+
+    uint32_t rng = seed ? seed : 1;
+    const auto t0 = std::chrono::steady_clock::now();
+    uint64_t run = 0;
+    for (; run < random_runs; ++run) {
+        std::vector<uint8_t> v(4 + MAX_BYTES + 2 + (xorshift32(rng) % 24));
+        for (auto &b : v) b = (uint8_t)xorshift32(rng);
+        if (!fails(v)) continue;
+
+        ++failures;
+        const std::vector<uint8_t> small = minimise(v);
+        char name[64];
+        snprintf(name, sizeof(name), "crash-K%d-s%u-%llu.bin", TB_K, seed, (unsigned long long)run);
+        FILE *out = fopen(name, "wb");
+        if (out) {
+            fwrite(small.data(), 1, small.size(), out);
+            fclose(out);
+        }
+        printf("FAIL run=%llu: %s -> %s (%zu bytes)\n", (unsigned long long)run,
+               check(small.data(), small.size()).c_str(), name, small.size());
+        if (failures >= 10) break;
+    }
+
+    harness().top->final();
+    printf("K=%d inputs=%llu failures=%d\n", TB_K,
+           (unsigned long long)(files.size() + regress_runs + random_runs), failures);
+    if (run) {
+        const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        printf("K=%d %llu random frames in %.1f s: %.0f frames/hour\n", TB_K,
+               (unsigned long long)run, s, s > 0 ? run * 3600.0 / s : 0.0);
+    }
+    return failures ? 1 : 0;
+}
+
+#endif
@@ -0,0 +1,170 @@
+# SPDX-License-Identifier: Apache-2.0
+"""Persistent on-disk cache of C golden vectors.
+
+Vector files are produced by ../c-tests/gen_golden_vectors.c in the binary
+format documented in ../c-tests/golden_vectors.h. Both the compiled generator
+and its output are stored in a content-addressed cache directory, keyed by
+(K, G0, G1, MAX_FRAME, generator source hash, seed, random frame count), so
+repeated `make TB_K=...` runs and parallel simulation jobs reuse them instead
+of recompiling.
+
+Cache directory: $VITERBI_GOLDEN_CACHE, else $XDG_CACHE_HOME/viterbi-golden,
+else ~/.cache/viterbi-golden.
+
+Entries are created under an exclusive flock and published with os.replace(),
+so readers only ever see complete files and concurrent jobs that miss at the
+same time generate each entry once. A hit costs a stat() and an mmap().
+
+Command line (prints the path of the vector file, generating it if needed):
+    python3 golden_cache.py --k 5 [--seed 1] [--random 0] [--max-frame 32]
+"""
+
+import argparse
+import fcntl
+import hashlib
+import mmap
+import os
+import struct
+import subprocess
+import tempfile
+
+FORMAT_VERSION = 1
+
+C_TESTS_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'c-tests')
+GEN_SOURCES = ('gen_golden_vectors.c', 'golden_vectors.h')
+
+# Generator polynomials (octal) used by tb.v for each supported K
+K_CONFIG = {
+    3: (0o7, 0o5),
+    5: (0o23, 0o35),
+    7: (0o171, 0o133),
+}
+
+GV_MAGIC = b'VGV1'
+GV_HEADER = struct.Struct('<4sHHHHHHIIII')
+GV_RECORD_HEAD = struct.Struct('<24sBBHHH')
+
+
+def cache_dir():
+    path = os.environ.get('VITERBI_GOLDEN_CACHE')
+    if not path:
+        base = os.environ.get('XDG_CACHE_HOME') or os.path.join(os.path.expanduser('~'), '.cache')
+        path = os.path.join(base, 'viterbi-golden')
+    os.makedirs(path, exist_ok=True)
+    return path
+
+
+def _source_hash():
+    h = hashlib.sha256()
+    for name in GEN_SOURCES:
+        with open(os.path.join(C_TESTS_DIR, name), 'rb') as f:
+            h.update(name.encode())
+            h.update(f.read())
+    return h.hexdigest()
+
+
+def _key(*fields):
+    return hashlib.sha256(repr((FORMAT_VERSION,) + fields).encode()).hexdigest()[:32]
+
+
+def _publish(final_path, produce):
+    """Create final_path via produce(tmp_path) exactly once across processes."""
+    if os.path.exists(final_path):
+        return final_path
+    directory = os.path.dirname(final_path)
+    with open(final_path + '.lock', 'a') as lock:
+        fcntl.flock(lock, fcntl.LOCK_EX)
+        if not os.path.exists(final_path):
+            fd, tmp = tempfile.mkstemp(dir=directory, prefix='.tmp-')
+            os.close(fd)
+            try:
+                produce(tmp)
+                os.replace(tmp, final_path)
+            finally:
+                if os.path.exists(tmp):
+                    os.unlink(tmp)
+    return final_path
+
+
+def _generator(k, g0, g1, max_frame, src_hash):
+    path = os.path.join(cache_dir(), 'gen-' + _key(k, g0, g1, max_frame, src_hash))
+
+    def build(tmp):
+        cmd = [
+            'gcc', '-O2', f'-DK={k}', f'-DG0_OCT=0{g0:o}', f'-DG1_OCT=0{g1:o}',
+            f'-DMAX_FRAME={max_frame}', '-I' + C_TESTS_DIR,
+            os.path.join(C_TESTS_DIR, 'gen_golden_vectors.c'), '-o', tmp, '-lm'
+        ]
+        subprocess.run(cmd, check=True)
+        os.chmod(tmp, 0o755)
+
+    return _publish(path, build)
+
+
+def vector_file(k, g0=None, g1=None, max_frame=32, seed=1, num_random=0):
+    """Return the path of the cached binary vector file, generating it on a miss."""
+    if g0 is None or g1 is None:
+        g0, g1 = K_CONFIG[k]
+    src_hash = _source_hash()
+    path = os.path.join(cache_dir(),
+                        'vec-' + _key(k, g0, g1, max_frame, src_hash, seed, num_random) + '.bin')
+    if os.path.exists(path):
+        return path
+
+    gen = _generator(k, g0, g1, max_frame, src_hash)
+
+    def generate(tmp):
+        subprocess.run([gen, '-b', tmp, '-s', str(seed), '-r', str(num_random)], check=True)
+        os.chmod(tmp, 0o644)
+
+    return _publish(path, generate)
+
+
+def load_vectors(path):
+    """Map a binary vector file and return it in the JSON layout of gen_golden_vectors."""
+    with open(path, 'rb') as f:
+        mm = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+    try:
+        (magic, k, m, g0, g1, max_frame, _, num_tests, seed,
+         record_size, _) = GV_HEADER.unpack_from(mm, 0)
+        if magic != GV_MAGIC or record_size != GV_RECORD_HEAD.size + 3 * max_frame:
+            raise ValueError(f'{path}: not a golden vector file')
+
+        tests = []
+        for i in range(num_tests):
+            off = GV_HEADER.size + i * record_size
+            name, noisy, _, n_bits, n_syms, n_dec = GV_RECORD_HEAD.unpack_from(mm, off)
+            off += GV_RECORD_HEAD.size
+            tests.append({
+                'name': name.rstrip(b'\0').decode(),
+                'noisy': bool(noisy),
+                'num_data_bits': n_bits,
+                'bits': list(mm[off:off + n_bits]),
+                'symbols': list(mm[off + max_frame:off + max_frame + n_syms]),
+                'decoded': list(mm[off + 2 * max_frame:off + 2 * max_frame + n_dec]),
+            })
+    finally:
+        mm.close()
+
+    return {'k': k, 'm': m, 'g0': g0, 'g1': g1, 'max_frame': max_frame,
+            'seed': seed, 'tests': tests}
+
+
+def get_vectors(k, **kwargs):
+    return load_vectors(vector_file(k, **kwargs))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split('\n\n')[0])
+    ap.add_argument('--k', type=int, default=5)
+    ap.add_argument('--g0', type=lambda s: int(s, 8), default=None, help='octal')
+    ap.add_argument('--g1', type=lambda s: int(s, 8), default=None, help='octal')
+    ap.add_argument('--max-frame', type=int, default=32)
+    ap.add_argument('--seed', type=int, default=1)
+    ap.add_argument('--random', type=int, default=0, help='extra random frames')
+    args = ap.parse_args()
+    print(vector_file(args.k, args.g0, args.g1, args.max_frame, args.seed, args.random))
+
+
+if __name__ == '__main__':
+    main()
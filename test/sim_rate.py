@@ -0,0 +1,36 @@
+# SPDX-License-Identifier: Apache-2.0
+"""Frames per second of the cocotb golden comparison, for comparison with
+the Verilator harness (make -f Makefile.verilator speed).
+
+Reads the wall-clock time of test_viterbi_golden_comparison from a cocotb
+results.xml and divides the clean golden frames it decodes (golden_cache.py,
+seed 1) by it:
+    python3 sim_rate.py [--k 5] [results.xml]
+"""
+
+import argparse
+import xml.etree.ElementTree as ET
+
+import golden_cache
+
+TEST = 'test_viterbi_golden_comparison'
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split('\n\n')[0])
+    ap.add_argument('--k', type=int, default=5, help='TB_K of the cocotb run')
+    ap.add_argument('results', nargs='?', default='results.xml')
+    args = ap.parse_args()
+
+    case = ET.parse(args.results).getroot().find(f".//testcase[@name='{TEST}']")
+    if case is None:
+        raise SystemExit(f'{args.results}: no {TEST}')
+    wall = float(case.get('time'))
+    sim_ns = float(case.get('sim_time_ns'))
+    frames = sum(1 for t in golden_cache.get_vectors(args.k)['tests'] if not t['noisy'])
+    print(f'cocotb K={args.k}: {frames} frames in {wall:.3f} s wall, '
+          f'{sim_ns / 1e3:.1f} us simulated: {frames / wall:.1f} frames/s')
+
+
+if __name__ == '__main__':
+    main()
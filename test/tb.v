@@ -8,6 +8,22 @@ module tb ();
   `define TB_K 5
 `endif
 
+`ifndef TB_ACS_PAR
+  `define TB_ACS_PAR 0
+`endif
+
+`ifndef TB_RADIX
+  `define TB_RADIX 2
+`endif
+
+`ifndef TB_BEST_SEARCH
+  `define TB_BEST_SEARCH 0
+`endif
+
+`ifndef TB_SOFT
+  `define TB_SOFT 0
+`endif
+
   localparam TB_K = `TB_K;
 
   // Generator polynomials for each K
@@ -48,7 +64,11 @@ module tb ();
       #(
           .K      (TB_K),
           .G0_OCT (TB_G0),
-          .G1_OCT (TB_G1)
+          .G1_OCT (TB_G1),
+          .ACS_PAR(`TB_ACS_PAR),
+          .RADIX  (`TB_RADIX),
+          .BEST_SEARCH(`TB_BEST_SEARCH),
+          .SOFT   (`TB_SOFT)
       )
 `endif
       dut (
@@ -0,0 +1,143 @@
+`timescale 1ns/1ps
+
+//=============================================================================
+// acs4_unit Testbench
+//=============================================================================
+// Feeds random symbol pairs to the radix-4 trellis and checks every state's
+// metric and 2-bit decision against two steps of the behavioural radix-2
+// model from tb_acs_unit.v: dec must name the predecessor the radix-2
+// decisions would trace back to, ties included. Override K with
+//   iverilog -g2012 -Ptb_acs4_unit.K=7 ...
+// (Makefile.acs4_unit runs K=3, 5 and 7.)
+//
+// Test Coverage:
+//   T0: init_frame loads state 0 = 0, others = max metric
+//   T1: STEPS random symbol pairs, all states checked each cycle
+//   T2: half, after T1: one radix-2 step on rx_sym0, dec = {0, decision}
+//=============================================================================
+
+module tb_acs4_unit;
+
+  parameter K      = 5;
+  parameter G0_OCT = (K == 3) ? 'o7 : (K == 7) ? 'o171 : 'o23;
+  parameter G1_OCT = (K == 3) ? 'o5 : (K == 7) ? 'o133 : 'o35;
+  parameter Wm     = 8;
+  parameter STEPS  = 16;
+
+  localparam M = K - 1;
+  localparam S = 1 << M;
+  localparam [K-1:0] G0M = G0_OCT;
+  localparam [K-1:0] G1M = G1_OCT;
+
+  reg             clk, rst;
+  reg             init_frame, wr_en, half;
+  reg  [1:0]      rx_sym0, rx_sym1;
+  wire [S*Wm-1:0] pm_out;
+  wire [2*S-1:0]  dec;
+
+  acs4_unit #(.K(K), .G0_OCT(G0_OCT), .G1_OCT(G1_OCT), .Wm(Wm)) dut (
+      .clk(clk), .rst(rst), .init_frame(init_frame), .init_flat(1'b0),
+      .rx_sym0(rx_sym0), .rx_sym1(rx_sym1), .half(half), .wr_en(wr_en),
+      .pm_out(pm_out), .dec(dec)
+  );
+
+  initial begin clk = 0; forever #5 clk = ~clk; end
+
+  // Behavioural radix-2 model
+  integer ref_pm  [0:S-1];
+  integer ref_new [0:S-1];
+  reg     ref_sv  [0:S-1];
+  reg     sv1     [0:S-1];
+
+  function [1:0] enc_sym(input integer pred, input integer b);
+    reg [K-1:0] r;
+    begin
+      r = {pred[M-1:0], b[0]};
+      enc_sym = {^(r & G0M), ^(r & G1M)};
+    end
+  endfunction
+
+  function integer ham(input [1:0] a, input [1:0] e);
+    ham = (a[0] ^ e[0]) + (a[1] ^ e[1]);
+  endfunction
+
+  task ref_step(input [1:0] r);
+    integer s, p0, p1, m0, m1;
+    begin
+      for (s = 0; s < S; s = s + 1) begin
+        p0 = s >> 1;
+        p1 = (s >> 1) | (1 << (M - 1));
+        m0 = (ref_pm[p0] + ham(r, enc_sym(p0, s & 1))) % (1 << Wm);
+        m1 = (ref_pm[p1] + ham(r, enc_sym(p1, s & 1))) % (1 << Wm);
+        ref_sv[s]  = (m1 < m0);
+        ref_new[s] = (m1 < m0) ? m1 : m0;
+      end
+      for (s = 0; s < S; s = s + 1) ref_pm[s] = ref_new[s];
+    end
+  endtask
+
+  integer errors, t, st, q;
+  reg [1:0] exp_dec;
+
+  initial begin
+    errors = 0;
+    rst = 1; init_frame = 0; wr_en = 0; half = 0; rx_sym0 = 0; rx_sym1 = 0;
+    repeat (3) @(posedge clk);
+    #1 rst = 0;
+
+    // T0
+    init_frame = 1;
+    @(posedge clk); #1 init_frame = 0;
+    for (st = 0; st < S; st = st + 1) ref_pm[st] = (st == 0) ? 0 : (1 << (Wm - 1)) - 1;
+
+    // T1
+    for (t = 0; t < STEPS; t = t + 1) begin
+      rx_sym0 = $random;
+      rx_sym1 = $random;
+      ref_step(rx_sym0);
+      for (st = 0; st < S; st = st + 1) sv1[st] = ref_sv[st];
+      ref_step(rx_sym1);
+      #1;
+      for (st = 0; st < S; st = st + 1) begin
+        q = (st >> 1) | (ref_sv[st] << (M - 1));
+        exp_dec = {sv1[q], ref_sv[st]};
+        if (pm_out[st*Wm +: Wm] !== ref_pm[st][Wm-1:0] || dec[2*st +: 2] !== exp_dec) begin
+          if (errors < 10)
+            $display("FAIL t=%0d state=%0d pm=%0d/%0d dec=%b/%b", t, st,
+                     pm_out[st*Wm +: Wm], ref_pm[st], dec[2*st +: 2], exp_dec);
+          errors = errors + 1;
+        end
+      end
+      wr_en = 1;
+      @(posedge clk); #1 wr_en = 0;
+    end
+
+    // T2: rx_sym1 must not matter
+    half = 1;
+    for (t = 0; t < 4; t = t + 1) begin
+      rx_sym0 = $random;
+      rx_sym1 = $random;
+      ref_step(rx_sym0);
+      #1;
+      for (st = 0; st < S; st = st + 1) begin
+        exp_dec = {1'b0, ref_sv[st]};
+        if (pm_out[st*Wm +: Wm] !== ref_pm[st][Wm-1:0] || dec[2*st +: 2] !== exp_dec) begin
+          if (errors < 10)
+            $display("FAIL half t=%0d state=%0d pm=%0d/%0d dec=%b/%b", t, st,
+                     pm_out[st*Wm +: Wm], ref_pm[st], dec[2*st +: 2], exp_dec);
+          errors = errors + 1;
+        end
+      end
+      wr_en = 1;
+      @(posedge clk); #1 wr_en = 0;
+    end
+    half = 0;
+
+    if (errors == 0)
+      $display("PASS: acs4_unit K=%0d, %0d symbol pairs + 4 half steps", K, STEPS);
+    else
+      $display("FAIL: acs4_unit K=%0d, %0d errors", K, errors);
+    $finish;
+  end
+
+endmodule
@@ -0,0 +1,181 @@
+`timescale 1ns/1ps
+
+//=============================================================================
+// acs_pipe Testbench
+//=============================================================================
+// Issues random trellis steps into acs_pipe, one state per cycle, and checks
+// every metric and decision that comes out against the same behavioural
+// full-trellis model as tb_acs_unit.v (ties pick predecessor p0). Steps are
+// issued back to back or with a random gap of up to GAP idle cycles, so both
+// the write-port forward (K = 3) and the bank handover between overlapping
+// steps are exercised. SOFT = Q feeds random Q-bit sample pairs through
+// soft_bm instead of 2-bit hard symbols. Override K / SOFT with iverilog -P,
+// e.g.
+//   iverilog -g2012 -Ptb_acs_pipe.K=3 -Ptb_acs_pipe.SOFT=3 ...
+// (Makefile.acs_pipe runs K = 3, 4, 5 and 7, and K = 3, 5 with SOFT = 3.)
+//
+// Test Coverage:
+//   T0: init_frame loads state 0 = 0, others = max metric
+//   T1: STEPS random symbols, every state checked in issue order, pend
+//       low once the last state has left the ACS stage
+//   T2: init_frame with init_flat, a second frame from all-zero metrics
+//=============================================================================
+
+module tb_acs_pipe;
+
+  parameter K      = 5;
+  parameter G0_OCT = (K == 3) ? 'o7 : (K == 4) ? 'o17 : (K == 7) ? 'o171 : 'o23;
+  parameter G1_OCT = (K == 3) ? 'o5 : (K == 4) ? 'o15 : (K == 7) ? 'o133 : 'o35;
+  parameter SOFT   = 0;
+  parameter Wm     = SOFT ? 11 : 8;
+  parameter STEPS  = 24;
+  parameter GAP    = 3;
+
+  localparam M = K - 1;
+  localparam S = 1 << M;
+  localparam [K-1:0] G0M = G0_OCT;
+  localparam [K-1:0] G1M = G1_OCT;
+  localparam SW = SOFT ? 2 * SOFT : 2;
+  localparam Wb = SOFT ? SOFT + 1 : 2;
+  localparam L  = (1 << SOFT) - 1;     // soft sample range 0 .. L
+
+  reg           clk, rst;
+  reg           init_frame, init_flat, in_valid;
+  reg  [M-1:0]  in_idx;
+  reg  [SW-1:0] rx_sym;
+  wire          out_valid, out_surv, pend;
+  wire [M-1:0]  out_idx;
+  wire [Wm-1:0] out_pm;
+
+  acs_pipe #(.K(K), .G0_OCT(G0_OCT), .G1_OCT(G1_OCT), .Wm(Wm), .Wb(Wb), .SOFT(SOFT)) dut (
+      .clk(clk), .rst(rst), .init_frame(init_frame), .init_flat(init_flat),
+      .in_valid(in_valid), .in_idx(in_idx), .rx_sym(rx_sym), .out_valid(out_valid),
+      .out_idx(out_idx), .out_pm(out_pm), .out_surv(out_surv), .pend(pend)
+  );
+
+  initial begin clk = 0; forever #5 clk = ~clk; end
+
+  // Behavioural model; exp_* hold every step of the frame, in issue order
+  integer ref_pm  [0:S-1];
+  integer ref_new [0:S-1];
+  reg     ref_sv  [0:S-1];
+  integer exp_pm  [0:STEPS*S-1];
+  reg     exp_sv  [0:STEPS*S-1];
+
+  function [1:0] enc_sym(input integer pred, input integer b);
+    reg [K-1:0] r;
+    begin
+      r = {pred[M-1:0], b[0]};
+      enc_sym = {^(r & G0M), ^(r & G1M)};
+    end
+  endfunction
+
+  // ham2, or soft_bm: each sample's distance from the expected bit
+  function integer bm(input [SW-1:0] a, input [1:0] e);
+    integer s1, s0;
+    begin
+      if (SOFT == 0) begin
+        bm = (a[0] ^ e[0]) + (a[1] ^ e[1]);
+      end else begin
+        s1 = (a >> SOFT) & L;
+        s0 = a & L;
+        bm = (e[1] ? L - s1 : s1) + (e[0] ? L - s0 : s0);
+      end
+    end
+  endfunction
+
+  task ref_step(input [SW-1:0] r);
+    integer s, p0, p1, m0, m1;
+    begin
+      for (s = 0; s < S; s = s + 1) begin
+        p0 = s >> 1;
+        p1 = (s >> 1) | (1 << (M - 1));
+        m0 = (ref_pm[p0] + bm(r, enc_sym(p0, s & 1))) % (1 << Wm);
+        m1 = (ref_pm[p1] + bm(r, enc_sym(p1, s & 1))) % (1 << Wm);
+        ref_sv[s]  = (m1 < m0);
+        ref_new[s] = (m1 < m0) ? m1 : m0;
+      end
+      for (s = 0; s < S; s = s + 1) ref_pm[s] = ref_new[s];
+    end
+  endtask
+
+  task ref_init(input flat);
+    integer s;
+    begin
+      for (s = 0; s < S; s = s + 1) ref_pm[s] = (s == 0 || flat) ? 0 : (1 << (Wm - 1)) - 1;
+    end
+  endtask
+
+  // Checker: outputs must come in issue order
+  integer errors, n_out;
+
+  always @(posedge clk) begin
+    if (out_valid) begin
+      if (out_idx !== n_out % S || out_pm !== exp_pm[n_out][Wm-1:0] ||
+          out_surv !== exp_sv[n_out]) begin
+        if (errors < 10)
+          $display("FAIL t=%0d state=%0d/%0d pm=%0d/%0d surv=%0d/%0d", n_out / S, out_idx,
+                   n_out % S, out_pm, exp_pm[n_out], out_surv, exp_sv[n_out]);
+        errors = errors + 1;
+      end
+      n_out = n_out + 1;
+    end
+  end
+
+  integer t, st, g, fr;
+
+  initial begin
+    errors = 0;
+    rst = 1; init_frame = 0; init_flat = 0; in_valid = 0; in_idx = 0; rx_sym = 0;
+    repeat (3) @(posedge clk);
+    #1 rst = 0;
+
+    for (fr = 0; fr < 2; fr = fr + 1) begin
+      // T0 / T2: start metrics
+      n_out = 0;
+      init_frame = 1;
+      init_flat  = (fr == 1);
+      @(posedge clk); #1 init_frame = 0;
+      ref_init(init_flat);
+
+      // T1: random steps, back to back or with a gap
+      for (t = 0; t < STEPS; t = t + 1) begin
+        rx_sym = $random;
+        ref_step(rx_sym);
+        for (st = 0; st < S; st = st + 1) begin
+          exp_pm[t*S+st] = ref_new[st];
+          exp_sv[t*S+st] = ref_sv[st];
+        end
+        for (st = 0; st < S; st = st + 1) begin
+          in_valid = 1; in_idx = st;
+          @(posedge clk); #1;
+        end
+        in_valid = 0;
+        g = $urandom % (GAP + 1);
+        if (g > 0) begin
+          repeat (g) @(posedge clk);
+          #1;
+        end
+      end
+
+      @(posedge clk); #1;
+      if (pend !== 1'b0) begin
+        $display("FAIL pend still high after the last state");
+        errors = errors + 1;
+      end
+      repeat (2) @(posedge clk);
+      #1;
+      if (n_out != STEPS * S) begin
+        $display("FAIL frame %0d: %0d of %0d results", fr, n_out, STEPS * S);
+        errors = errors + 1;
+      end
+    end
+
+    if (errors == 0)
+      $display("PASS: acs_pipe K=%0d SOFT=%0d, 2 frames of %0d steps", K, SOFT, STEPS);
+    else
+      $display("FAIL: acs_pipe K=%0d SOFT=%0d, %0d errors", K, SOFT, errors);
+    $finish;
+  end
+
+endmodule
@@ -0,0 +1,131 @@
+`timescale 1ns/1ps
+
+//=============================================================================
+// acs_unit Testbench
+//=============================================================================
+// Runs random trellis steps through acs_unit (P butterflies per cycle over
+// pm_bank_wide) and checks every group's new metrics and decisions against a
+// behavioural full-trellis model written the same way as viterbi_golden.c
+// (ties pick predecessor p0). Override K / P with iverilog -P, e.g.
+//   iverilog -g2012 -Ptb_acs_unit.K=7 -Ptb_acs_unit.P=8 ...
+// (Makefile.acs_unit loops over every legal P for K=3, 5 and 7; P = S/2
+// covers the fully parallel register store, where the swaps are no-ops.)
+//
+// Test Coverage:
+//   T0: init_frame loads state 0 = 0, others = max metric
+//   T1: STEPS random symbols, every group checked, then bank swap
+//=============================================================================
+
+module tb_acs_unit;
+
+  parameter K      = 5;
+  parameter P      = 2;
+  parameter G0_OCT = (K == 3) ? 'o7 : (K == 7) ? 'o171 : 'o23;
+  parameter G1_OCT = (K == 3) ? 'o5 : (K == 7) ? 'o133 : 'o35;
+  parameter Wm     = 8;
+  parameter STEPS  = 24;
+
+  localparam M      = K - 1;
+  localparam S      = 1 << M;
+  localparam GROUPS = S / (2 * P);
+  localparam GB     = (GROUPS > 1) ? $clog2(GROUPS) : 1;
+  localparam [K-1:0] G0M = G0_OCT;
+  localparam [K-1:0] G1M = G1_OCT;
+
+  reg               clk, rst;
+  reg               init_frame, swap_banks, wr_en;
+  reg  [GB-1:0]     rd_grp, wr_row;
+  reg  [1:0]        rx_sym;
+  reg  [2*P*Wm-1:0] wr_pm;
+  wire [2*P*Wm-1:0] pm_out;
+  wire [2*P-1:0]    surv;
+  wire              prev_A;
+
+  acs_unit #(.K(K), .G0_OCT(G0_OCT), .G1_OCT(G1_OCT), .Wm(Wm), .P(P)) dut (
+      .clk(clk), .rst(rst), .init_frame(init_frame), .init_flat(1'b0),
+      .swap_banks(swap_banks),
+      .rd_grp(rd_grp), .rx_sym(rx_sym), .wr_en(wr_en), .wr_row(wr_row), .wr_pm(wr_pm),
+      .pm_out(pm_out), .surv(surv), .prev_A(prev_A)
+  );
+
+  initial begin clk = 0; forever #5 clk = ~clk; end
+
+  // Behavioural model
+  integer ref_pm  [0:S-1];
+  integer ref_new [0:S-1];
+  reg     ref_sv  [0:S-1];
+
+  function [1:0] enc_sym(input integer pred, input integer b);
+    reg [K-1:0] r;
+    begin
+      r = {pred[M-1:0], b[0]};
+      enc_sym = {^(r & G0M), ^(r & G1M)};
+    end
+  endfunction
+
+  function integer ham(input [1:0] a, input [1:0] e);
+    ham = (a[0] ^ e[0]) + (a[1] ^ e[1]);
+  endfunction
+
+  task ref_step(input [1:0] r);
+    integer s, p0, p1, m0, m1;
+    begin
+      for (s = 0; s < S; s = s + 1) begin
+        p0 = s >> 1;
+        p1 = (s >> 1) | (1 << (M - 1));
+        m0 = (ref_pm[p0] + ham(r, enc_sym(p0, s & 1))) % (1 << Wm);
+        m1 = (ref_pm[p1] + ham(r, enc_sym(p1, s & 1))) % (1 << Wm);
+        ref_sv[s]  = (m1 < m0);
+        ref_new[s] = (m1 < m0) ? m1 : m0;
+      end
+      for (s = 0; s < S; s = s + 1) ref_pm[s] = ref_new[s];
+    end
+  endtask
+
+  integer errors, t, g, i, st;
+
+  initial begin
+    errors = 0;
+    rst = 1; init_frame = 0; swap_banks = 0; wr_en = 0;
+    rd_grp = 0; wr_row = 0; rx_sym = 0; wr_pm = 0;
+    repeat (3) @(posedge clk);
+    #1 rst = 0;
+
+    // T0: init the current bank, then make it the previous bank
+    init_frame = 1;
+    @(posedge clk); #1 init_frame = 0;
+    swap_banks = 1;
+    @(posedge clk); #1 swap_banks = 0;
+    for (st = 0; st < S; st = st + 1) ref_pm[st] = (st == 0) ? 0 : (1 << (Wm - 1)) - 1;
+
+    // T1: random steps
+    for (t = 0; t < STEPS; t = t + 1) begin
+      rx_sym = $random;
+      ref_step(rx_sym);
+      for (g = 0; g < GROUPS; g = g + 1) begin
+        rd_grp = g;
+        #1;
+        for (i = 0; i < 2 * P; i = i + 1) begin
+          st = g * 2 * P + i;
+          if (pm_out[i*Wm +: Wm] !== ref_new[st][Wm-1:0] || surv[i] !== ref_sv[st]) begin
+            if (errors < 10)
+              $display("FAIL t=%0d state=%0d pm=%0d/%0d surv=%0d/%0d", t, st,
+                       pm_out[i*Wm +: Wm], ref_new[st], surv[i], ref_sv[st]);
+            errors = errors + 1;
+          end
+        end
+        wr_en = 1; wr_row = g; wr_pm = pm_out;
+        @(posedge clk); #1 wr_en = 0;
+      end
+      swap_banks = 1;
+      @(posedge clk); #1 swap_banks = 0;
+    end
+
+    if (errors == 0)
+      $display("PASS: acs_unit K=%0d P=%0d, %0d steps", K, P, STEPS);
+    else
+      $display("FAIL: acs_unit K=%0d P=%0d, %0d errors", K, P, errors);
+    $finish;
+  end
+
+endmodule
@@ -0,0 +1,265 @@
+// Live random regression of the ping-pong mode (NBUF = 2) of
+// tt_um_ashvin_viterbi against the C golden model, through the same $vit_*
+// VPI functions as tb_top_live.v:
+//
+//   make -f Makefile.dpi chain TB_K=5 FRAMES=2000 SEED=3 P_ERR=0.02
+//
+// Frames are sent back to back: each frame's bytes, then START, then the
+// next frame's bytes straight away, while output bytes are read whenever
+// BYTE_OUT_VALID is up. Up to QD frames are in flight, so the expected
+// decode of each is kept here rather than in the VPI state. The host idles
+// on a random +gap percent of cycles to shuffle the receive / decode /
+// output overlap. Plusargs: +frames=N +seed=S +p=P +gap=PCT.
+//
+// Every fourth frame is as long as a terminated frame can be, so it fills
+// its slot exactly; with TB_MAX_FRAME not a multiple of 4 its last byte
+// carries padding symbols past the slot, which must be dropped (the slot
+// keeps MAX_FRAME symbols and the next slot is untouched).
+//
+// TB_PUNCT = p builds the top with PUNCT = p and sends only the kept bits
+// of each symbol (c-tests/punct.h). A byte then completes up to 6 symbols,
+// so a full frame's padding can run further past the slot. Punctured
+// frames are sent noiseless (+p is ignored) and checked against the
+// message bits.
+//
+// TB_IN_FIFO / TB_OUT_FIFO set IN_FIFO / OUT_FIFO, and the bench also checks
+// the FIFO flags on uo_out[7:5]: BYTE_IN_READY low with no output byte up
+// means D - 1 entries queued, so from D = 4 up the almost-full flag must be
+// up, and a FIFO that is not there raises none. With the input FIFO, START
+// goes out as soon as a frame's bytes are in, whatever BYTE_IN_READY says:
+// the last entry is kept for it. The bench counts STARTs sent with
+// BYTE_IN_READY low and fails if none was (IN_FIFO = 2 makes them common);
+// a lost one would merge two frames and fail the data check.
+`timescale 1ns/1ps
+
+module tb_chain_live();
+
+`ifndef TB_K
+  `define TB_K 5
+`endif
+
+`ifndef TB_ACS_PAR
+  `define TB_ACS_PAR 0
+`endif
+
+`ifndef TB_RADIX
+  `define TB_RADIX 2
+`endif
+
+`ifndef TB_MAX_FRAME
+  `define TB_MAX_FRAME 32
+`endif
+
+`ifndef TB_PUNCT
+  `define TB_PUNCT 0
+`endif
+
+`ifndef TB_IN_FIFO
+  `define TB_IN_FIFO 0
+`endif
+
+`ifndef TB_OUT_FIFO
+  `define TB_OUT_FIFO 0
+`endif
+
+  localparam TB_K = `TB_K;
+  localparam TB_G0 = (TB_K == 3) ? 'o7  :
+                     (TB_K == 5) ? 'o23 :
+                     (TB_K == 7) ? 'o171 : 'o23;
+  localparam TB_G1 = (TB_K == 3) ? 'o5  :
+                     (TB_K == 5) ? 'o35 :
+                     (TB_K == 7) ? 'o133 : 'o35;
+  localparam MAX_FRAME = `TB_MAX_FRAME;
+  localparam QS        = MAX_FRAME + 4;   // per-frame stride, with padding
+  localparam QB        = QS / 4;          // input bytes per frame, at most
+  localparam PUNCT     = `TB_PUNCT;
+  localparam UNITS     = (PUNCT == 2) ? 4 : (PUNCT == 1) ? 3 : 2;   // kept bits per period
+  localparam IN_FIFO   = `TB_IN_FIFO;
+  localparam OUT_FIFO  = `TB_OUT_FIFO;
+  // Frames in flight: slots, plus one per FIFO entry at worst
+  localparam QD        = 8 + IN_FIFO + OUT_FIFO;
+
+  reg  [7:0] ui_in;
+  wire [7:0] uo_out;
+  reg  [7:0] uio_in;
+  wire [7:0] uio_out;
+  wire [7:0] uio_oe;
+  reg        clk, rst_n;
+
+  initial begin clk = 0; forever #5 clk = ~clk; end
+
+  tt_um_ashvin_viterbi #(.K(TB_K), .G0_OCT(TB_G0), .G1_OCT(TB_G1), .ACS_PAR(`TB_ACS_PAR),
+                         .RADIX(`TB_RADIX), .MAX_FRAME(MAX_FRAME), .PUNCT(PUNCT), .NBUF(2), .IN_FIFO(IN_FIFO),
+                         .OUT_FIFO(OUT_FIFO)) dut (
+    .ui_in(ui_in), .uo_out(uo_out), .uio_in(uio_in), .uio_out(uio_out),
+    .uio_oe(uio_oe), .ena(1'b1), .clk(clk), .rst_n(rst_n)
+  );
+
+  // In-flight frames, slot f % QD
+  reg [7:0] q_byte [0:QD*QB-1];
+  reg       q_dec  [0:QD*QS-1];
+  integer   q_nb  [0:QD-1];     // input bytes
+  integer   q_len [0:QD-1];     // symbols the slot keeps
+  integer   q_n   [0:QD-1];     // message bits
+  integer   q_err [0:QD-1];
+
+  integer frames, seed, gap, dummy, i, j, n, T, T_pad, L, flips, fails, nbits, timeout;
+  integer sf, sent, rf, got, flag_errs, u, off, starts_held;
+  reg [1:0] s, keep;
+  real    p_err;
+  reg [7:0] b;
+
+  task new_frame(input integer f);
+    integer q;
+    begin
+      q = f % QD;
+      if (f % 4 == 3)
+        n = MAX_FRAME - TB_K + 1;
+      else
+        n = 1 + ($unsigned($random) % (MAX_FRAME - TB_K + 1));
+      dummy = $vit_rand_bits(n);
+      T = $vit_encode(n);
+      for (i = 0; i < QB; i = i + 1) q_byte[q * QB + i] = 0;
+      if (PUNCT == 0) begin
+        T_pad = (T + 3) & ~3;
+        for (i = T; i < T_pad; i = i + 1) dummy = $vit_set_sym(i, 0);
+        flips = (p_err > 0.0) ? $vit_bsc(T_pad, p_err) : 0;
+        for (i = 0; i < T_pad; i = i + 1)
+          q_byte[q * QB + i / 4] = q_byte[q * QB + i / 4] | ($vit_get_sym(i) << (2 * (i % 4)));
+        q_nb[q] = T_pad / 4;
+      end else begin
+        // kept bits, c1 before c0, first in the LSBs; the zero padding
+        // of the last byte completes symbols as well
+        u = 0;
+        for (i = 0; i < T; i = i + 1) begin
+          s = $vit_get_sym(i);
+          keep = (PUNCT == 1) ? ((i % 2) ? 2'b10 : 2'b11) :
+                 (i % 3 == 0) ? 2'b11 : (i % 3 == 1) ? 2'b01 : 2'b10;
+          if (keep[0]) begin q_byte[q * QB + u / 8] = q_byte[q * QB + u / 8] | (s[0] << (u % 8)); u = u + 1; end
+          if (keep[1]) begin q_byte[q * QB + u / 8] = q_byte[q * QB + u / 8] | (s[1] << (u % 8)); u = u + 1; end
+        end
+        q_nb[q] = (u + 7) / 8;
+        T_pad = 0; off = 0;
+        for (i = 0; i < 8 * q_nb[q]; i = i + 1) begin
+          if (off != 0) T_pad = T_pad + 1;
+          off = (off + 1) % UNITS;
+        end
+      end
+      // symbols past MAX_FRAME are padding the top drops
+      L = (T_pad < MAX_FRAME) ? T_pad : MAX_FRAME;
+      if (PUNCT == 0) begin
+        dummy = $vit_decode(L, 0);
+        for (i = 0; i < n; i = i + 1) q_dec[q * QS + i] = $vit_get_dec(i);
+      end else begin
+        for (i = 0; i < n; i = i + 1) q_dec[q * QS + i] = $vit_get_bit(i);
+      end
+      q_len[q] = L;
+      q_n[q]   = n;
+      q_err[q] = 0;
+    end
+  endtask
+
+  task pulse(input [7:0] bits);
+    begin
+      ui_in = bits;
+      @(posedge clk); #1;
+      ui_in = 8'h00;
+    end
+  endtask
+
+  initial begin
+    if (!$value$plusargs("frames=%d", frames)) frames = 500;
+    if (!$value$plusargs("seed=%d", seed))     seed   = 1;
+    if (!$value$plusargs("p=%f", p_err))       p_err  = 0.0;
+    if (!$value$plusargs("gap=%d", gap))       gap    = 25;
+
+    if ($vit_k() != TB_K) begin
+      $display("FAIL: VPI library built for K=%0d, bench is K=%0d", $vit_k(), TB_K);
+      $finish;
+    end
+    dummy = $vit_seed(seed);
+
+    ui_in = 0; uio_in = 0; rst_n = 0;
+    repeat (5) @(posedge clk);
+    #1 rst_n = 1;
+    repeat (2) @(posedge clk);
+    #1;
+
+    fails = 0; nbits = 0; flag_errs = 0; starts_held = 0;
+    sf = 0; sent = 0; rf = 0; got = 0; timeout = 0;
+    new_frame(0);
+
+    // sf / sent: frame being sent and its bytes sent so far;
+    // rf / got: frame being read and its bits read so far
+    while (rf < frames && timeout < 20000) begin
+      if ((IN_FIFO >= 4 && !uo_out[0] && !uo_out[1] && !uo_out[5]) ||
+          (IN_FIFO == 0 && uo_out[6:5] != 0) || (OUT_FIFO == 0 && uo_out[7])) begin
+        if (flag_errs < 10)
+          $display("FAIL FIFO flags uo_out=%b at frame %0d", uo_out, sf);
+        flag_errs = flag_errs + 1;
+      end
+      if (uo_out[1]) begin
+        for (j = 0; j < 8; j = j + 1)
+          if (got + j < q_n[rf % QD] && uio_out[j] !== q_dec[(rf % QD) * QS + got + j])
+            q_err[rf % QD] = q_err[rf % QD] + 1;
+        got = got + 8;
+        pulse(8'h10);
+        // a frame delivers ceil((L - M) / 8) bytes
+        if (got >= q_len[rf % QD] - (TB_K - 1)) begin
+          if (q_err[rf % QD] != 0) begin
+            fails = fails + 1;
+            $display("FAIL frame=%0d n=%0d errors=%0d", rf, q_n[rf % QD], q_err[rf % QD]);
+          end
+          nbits = nbits + q_n[rf % QD];
+          rf = rf + 1; got = 0;
+        end
+        timeout = 0;
+      end else if (($unsigned($random) % 100) < gap) begin
+        @(posedge clk); #1;
+        timeout = timeout + 1;
+      end else if (IN_FIFO != 0 && sf < frames && sent >= q_nb[sf % QD]) begin
+        // START needs no BYTE_IN_READY with the input FIFO
+        if (!uo_out[0]) starts_held = starts_held + 1;
+        pulse(8'h08);
+        sf = sf + 1; sent = 0;
+        if (sf < frames) new_frame(sf);
+        timeout = 0;
+      end else if (sf < frames && uo_out[0]) begin
+        if (sent < q_nb[sf % QD]) begin
+          uio_in = q_byte[(sf % QD) * QB + sent];
+          pulse(8'h01);
+          sent = sent + 1;
+        end else begin
+          // START queues the frame; the next one follows immediately
+          pulse(8'h08);
+          sf = sf + 1; sent = 0;
+          if (sf < frames) new_frame(sf);
+        end
+        timeout = 0;
+      end else begin
+        @(posedge clk); #1;
+        timeout = timeout + 1;
+      end
+    end
+
+    // Everything drained: DONE
+    while (!uo_out[4] && timeout < 20000) begin @(posedge clk); #1; timeout = timeout + 1; end
+
+    if (timeout >= 20000) begin
+      fails = fails + 1;
+      $display("FAIL timeout: sent %0d frames, read %0d", sf, rf);
+    end
+    if (flag_errs != 0) fails = fails + 1;
+    if (IN_FIFO != 0 && frames >= 100 && starts_held == 0) begin
+      fails = fails + 1;
+      $display("FAIL no START was sent with BYTE_IN_READY low");
+    end
+
+    $display("K=%0d MAX_FRAME=%0d PUNCT=%0d IN_FIFO=%0d OUT_FIFO=%0d seed=%0d frames=%0d bits=%0d p=%f gap=%0d held_starts=%0d fails=%0d",
+             TB_K, MAX_FRAME, PUNCT, IN_FIFO, OUT_FIFO, seed, frames, nbits, p_err, gap,
+             starts_held, fails);
+    if (fails == 0) $display("PASS");
+    $finish;
+  end
+
+endmodule
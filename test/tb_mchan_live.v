@@ -0,0 +1,202 @@
+// Live random regression of the multi-channel mode (NCTX) of
+// tt_um_ashvin_viterbi against the C golden model, through the same $vit_*
+// VPI functions as tb_top_live.v:
+//
+//   make -f Makefile.dpi mchan TB_K=5 NCTX=4 FRAMES=500 SEED=3 P_ERR=0.02
+//
+// Every cycle the host picks a random channel and, if its BYTE_IN_READY is
+// up with that channel on ui_in[7:5], sends it the next byte of its current
+// frame, or START once the frame is complete. Frames of different channels
+// are therefore interleaved byte by byte, each with its own random length.
+// Output bytes are read whenever BYTE_OUT_VALID is up and checked against
+// the channel named on uo_out[7:5], whose frames must come out in order.
+// The host idles on a random +gap percent of cycles.
+// Plusargs: +frames=N (per channel) +seed=S +p=P +gap=PCT.
+`timescale 1ns/1ps
+
+module tb_mchan_live();
+
+`ifndef TB_K
+  `define TB_K 5
+`endif
+
+`ifndef TB_ACS_PAR
+  `define TB_ACS_PAR 0
+`endif
+
+`ifndef TB_RADIX
+  `define TB_RADIX 2
+`endif
+
+`ifndef TB_NCTX
+  `define TB_NCTX 4
+`endif
+
+  localparam TB_K = `TB_K;
+  localparam TB_G0 = (TB_K == 3) ? 'o7  :
+                     (TB_K == 5) ? 'o23 :
+                     (TB_K == 7) ? 'o171 : 'o23;
+  localparam TB_G1 = (TB_K == 3) ? 'o5  :
+                     (TB_K == 5) ? 'o35 :
+                     (TB_K == 7) ? 'o133 : 'o35;
+  localparam MAX_FRAME = 32;
+  localparam NC        = `TB_NCTX;
+  localparam QD        = 4;
+
+  reg  [7:0] ui_in;
+  wire [7:0] uo_out;
+  reg  [7:0] uio_in;
+  wire [7:0] uio_out;
+  wire [7:0] uio_oe;
+  reg        clk, rst_n;
+
+  initial begin clk = 0; forever #5 clk = ~clk; end
+
+  tt_um_ashvin_viterbi #(.K(TB_K), .G0_OCT(TB_G0), .G1_OCT(TB_G1), .ACS_PAR(`TB_ACS_PAR),
+                         .RADIX(`TB_RADIX), .NCTX(NC)) dut (
+    .ui_in(ui_in), .uo_out(uo_out), .uio_in(uio_in), .uio_out(uio_out),
+    .uio_oe(uio_oe), .ena(1'b1), .clk(clk), .rst_n(rst_n)
+  );
+
+  // In-flight frames of channel c, slot c * QD + f % QD
+  reg [1:0] q_sym [0:NC*QD*MAX_FRAME-1];
+  reg       q_dec [0:NC*QD*MAX_FRAME-1];
+  integer   q_len [0:NC*QD-1];  // padded symbols
+  integer   q_n   [0:NC*QD-1];  // message bits
+  integer   q_err [0:NC*QD-1];
+
+  // Per channel: frame being sent and its symbols sent so far, frame
+  // being read and its bits read so far
+  integer sf [0:NC-1];
+  integer sent [0:NC-1];
+  integer rf [0:NC-1];
+  integer got [0:NC-1];
+
+  integer frames, seed, gap, dummy, i, j, n, T, T_pad, flips, fails, nbits, timeout;
+  integer c, q, read_frames;
+  real    p_err;
+  reg [7:0] b;
+
+  task new_frame(input integer ch, input integer f);
+    integer s;
+    begin
+      s = ch * QD + f % QD;
+      n = 1 + ($unsigned($random) % (MAX_FRAME - TB_K + 1));
+      dummy = $vit_rand_bits(n);
+      T = $vit_encode(n);
+      T_pad = (T + 3) & ~3;
+      for (i = T; i < T_pad; i = i + 1) dummy = $vit_set_sym(i, 0);
+      flips = (p_err > 0.0) ? $vit_bsc(T_pad, p_err) : 0;
+      dummy = $vit_decode(T_pad, 0);
+      for (i = 0; i < T_pad; i = i + 1) q_sym[s * MAX_FRAME + i] = $vit_get_sym(i);
+      for (i = 0; i < n; i = i + 1)     q_dec[s * MAX_FRAME + i] = $vit_get_dec(i);
+      q_len[s] = T_pad;
+      q_n[s]   = n;
+      q_err[s] = 0;
+    end
+  endtask
+
+  task pulse(input [7:0] bits);
+    begin
+      ui_in = bits;
+      @(posedge clk); #1;
+      ui_in = 8'h00;
+    end
+  endtask
+
+  initial begin
+    if (!$value$plusargs("frames=%d", frames)) frames = 200;
+    if (!$value$plusargs("seed=%d", seed))     seed   = 1;
+    if (!$value$plusargs("p=%f", p_err))       p_err  = 0.0;
+    if (!$value$plusargs("gap=%d", gap))       gap    = 25;
+
+    if ($vit_k() != TB_K) begin
+      $display("FAIL: VPI library built for K=%0d, bench is K=%0d", $vit_k(), TB_K);
+      $finish;
+    end
+    dummy = $vit_seed(seed);
+
+    ui_in = 0; uio_in = 0; rst_n = 0;
+    repeat (5) @(posedge clk);
+    #1 rst_n = 1;
+    repeat (2) @(posedge clk);
+    #1;
+
+    fails = 0; nbits = 0; timeout = 0; read_frames = 0;
+    for (c = 0; c < NC; c = c + 1) begin
+      sf[c] = 0; sent[c] = 0; rf[c] = 0; got[c] = 0;
+      new_frame(c, 0);
+    end
+
+    while (read_frames < NC * frames && timeout < 20000) begin
+      if (uo_out[1]) begin
+        c = uo_out[7:5];
+        q = c * QD + rf[c] % QD;
+        if (c >= NC || rf[c] >= sf[c]) begin
+          fails = fails + 1;
+          $display("FAIL output byte for channel %0d, which has no frame decoded", c);
+          pulse(8'h10);
+        end else begin
+          for (j = 0; j < 8; j = j + 1)
+            if (got[c] + j < q_n[q] && uio_out[j] !== q_dec[q * MAX_FRAME + got[c] + j])
+              q_err[q] = q_err[q] + 1;
+          got[c] = got[c] + 8;
+          pulse(8'h10);
+          // a frame delivers ceil((T_pad - M) / 8) bytes
+          if (got[c] >= q_len[q] - (TB_K - 1)) begin
+            if (q_err[q] != 0) begin
+              fails = fails + 1;
+              $display("FAIL channel=%0d frame=%0d n=%0d errors=%0d", c, rf[c], q_n[q], q_err[q]);
+            end
+            nbits = nbits + q_n[q];
+            rf[c] = rf[c] + 1; got[c] = 0;
+            read_frames = read_frames + 1;
+          end
+        end
+        timeout = 0;
+      end else if (($unsigned($random) % 100) < gap) begin
+        @(posedge clk); #1;
+        timeout = timeout + 1;
+      end else begin
+        // BYTE_IN_READY is that of the channel on ui_in[7:5]
+        c = $unsigned($random) % NC;
+        q = c * QD + sf[c] % QD;
+        ui_in = c << 5;
+        #1;
+        if (sf[c] < frames && uo_out[0]) begin
+          if (sent[c] < q_len[q]) begin
+            b = 0;
+            for (j = 0; j < 4; j = j + 1) b = b | (q_sym[q * MAX_FRAME + sent[c] + j] << (2 * j));
+            uio_in = b;
+            pulse(8'h01 | (c << 5));
+            sent[c] = sent[c] + 4;
+          end else begin
+            // START queues the channel's frame; its next one follows
+            pulse(8'h08 | (c << 5));
+            sf[c] = sf[c] + 1; sent[c] = 0;
+            if (sf[c] < frames) new_frame(c, sf[c]);
+          end
+          timeout = 0;
+        end else begin
+          ui_in = 0;
+          @(posedge clk); #1;
+          timeout = timeout + 1;
+        end
+      end
+    end
+
+    // Everything drained: DONE
+    while (!uo_out[4] && timeout < 20000) begin @(posedge clk); #1; timeout = timeout + 1; end
+
+    if (timeout >= 20000) begin
+      fails = fails + 1;
+      $display("FAIL timeout: read %0d of %0d frames", read_frames, NC * frames);
+    end
+
+    $display("K=%0d NCTX=%0d seed=%0d frames=%0d bits=%0d p=%f gap=%0d fails=%0d", TB_K, NC,
+             seed, NC * frames, nbits, p_err, gap, fails);
+    if (fails == 0) $display("PASS");
+    $finish;
+  end
+
+endmodule
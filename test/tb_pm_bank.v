@@ -19,6 +19,7 @@
 //   T6: Read-port semantics (dual ports, same/diff addresses)
 //   T7: Protocol checks (no write during swap, init_frame behavior)
 //   T8: Randomized sequence with behavioral model scoreboard
+//   T9: init_frame with init_flat: every state starts at 0
 //=============================================================================
 
 module tb_pm_bank;
@@ -37,6 +38,7 @@ module tb_pm_bank;
   reg clk;
   reg rst;
   reg init_frame;
+  reg init_flat;
   reg [M-1:0] rd_idx0;
   reg [M-1:0] rd_idx1;
   reg wr_en;
@@ -73,6 +75,7 @@ module tb_pm_bank;
     .clk(clk),
     .rst(rst),
     .init_frame(init_frame),
+    .init_flat(init_flat),
     .rd_idx0(rd_idx0),
     .rd_idx1(rd_idx1),
     .wr_en(wr_en),
@@ -159,6 +162,7 @@ module tb_pm_bank;
     begin
       rst = 1;
       init_frame = 0;
+      init_flat = 0;
       rd_idx0 = 0;
       rd_idx1 = 0;
       wr_en = 0;
@@ -539,6 +543,25 @@ module tb_pm_bank;
     
     end_test();
     
+    //=========================================================================
+    // T9: Flat start metrics (tail-biting frames)
+    //=========================================================================
+    start_test("T9: init_flat");
+    
+    apply_reset();
+    
+    init_flat = 1;
+    pulse_init_frame();
+    init_flat = 0;
+    do_swap();
+    
+    for (i = 0; i < S; i = i + 1) begin
+      check_read(i, 0, 0);
+    end
+    $display("    ✓ After init_frame with init_flat: every index is 0");
+    
+    end_test();
+    
     //=========================================================================
     // Summary
     //=========================================================================
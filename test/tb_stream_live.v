@@ -0,0 +1,137 @@
+// Live random regression of the continuous mode (CONTINUOUS = 1) of
+// tt_um_ashvin_viterbi against viterbi_decode_streaming() from the C golden
+// model, through the same $vit_* VPI functions as tb_top_live.v:
+//
+//   make -f Makefile.dpi stream TB_K=5 STREAMS=50 SEED=3 P_ERR=0.05
+//
+// Each stream is a random message, its code tail and TB_DEPTH-1 flush
+// symbols, sent byte by byte while output bytes are collected as they
+// appear. Decoded bit j must equal golden output j + TB_DEPTH-1 + K-1 (the
+// decoder drops that many warm-up bits). START then restarts the decoder
+// for the next stream. Plusargs: +streams=N +seed=S +p=P +maxbits=N.
+// TB_BLOCK = B builds the DUT with that TB_BLOCK, checks it against
+// $vit_decode_streaming_block and pads the flush to a whole block.
+`timescale 1ns/1ps
+
+module tb_stream_live();
+
+`ifndef TB_K
+  `define TB_K 5
+`endif
+
+`ifndef TB_DEPTH
+  `define TB_DEPTH 32
+`endif
+
+`ifndef TB_BLOCK
+  `define TB_BLOCK 1
+`endif
+
+  localparam TB_K = `TB_K;
+  localparam TB_G0 = (TB_K == 3) ? 'o7  :
+                     (TB_K == 5) ? 'o23 :
+                     (TB_K == 7) ? 'o171 : 'o23;
+  localparam TB_G1 = (TB_K == 3) ? 'o5  :
+                     (TB_K == 5) ? 'o35 :
+                     (TB_K == 7) ? 'o133 : 'o35;
+  localparam D    = `TB_DEPTH;
+  localparam B    = `TB_BLOCK;
+  localparam WARM = D - 1 + TB_K - 1;
+  localparam PAD  = (B > 4) ? B : 4;     // symbols per byte, or per block
+
+  reg  [7:0] ui_in;
+  wire [7:0] uo_out;
+  reg  [7:0] uio_in;
+  wire [7:0] uio_out;
+  wire [7:0] uio_oe;
+  reg        clk, rst_n;
+
+  initial begin clk = 0; forever #5 clk = ~clk; end
+
+  tt_um_ashvin_viterbi #(.K(TB_K), .G0_OCT(TB_G0), .G1_OCT(TB_G1),
+                         .CONTINUOUS(1), .TB_DEPTH(D), .TB_BLOCK(B)) dut (
+    .ui_in(ui_in), .uo_out(uo_out), .uio_in(uio_in), .uio_out(uio_out),
+    .uio_oe(uio_oe), .ena(1'b1), .clk(clk), .rst_n(rst_n)
+  );
+
+  integer streams, seed, maxbits, f, i, j, n, T, T_pad, flips, errors, fails;
+  integer sent, got_bits, idle, nbits, dummy;
+  real    p_err;
+  reg [7:0] b;
+
+  initial begin
+    if (!$value$plusargs("streams=%d", streams)) streams = 20;
+    if (!$value$plusargs("seed=%d", seed))       seed    = 1;
+    if (!$value$plusargs("p=%f", p_err))         p_err   = 0.0;
+    if (!$value$plusargs("maxbits=%d", maxbits)) maxbits = 2000;
+
+    if ($vit_k() != TB_K) begin
+      $display("FAIL: VPI library built for K=%0d, bench is K=%0d", $vit_k(), TB_K);
+      $finish;
+    end
+    dummy = $vit_seed(seed);
+
+    ui_in = 0; uio_in = 0; rst_n = 0;
+    repeat (5) @(posedge clk);
+    #1 rst_n = 1;
+
+    fails = 0; nbits = 0;
+    for (f = 0; f < streams; f = f + 1) begin
+      n = 1 + ($unsigned($random) % maxbits);
+      dummy = $vit_rand_bits(n);
+      T = $vit_encode(n);
+      T_pad = ((T + D - 1 + PAD - 1) / PAD) * PAD;
+      for (i = T; i < T_pad; i = i + 1) dummy = $vit_set_sym(i, 0);
+      flips = (p_err > 0.0) ? $vit_bsc(T, p_err) : 0;
+      if (B > 1)
+        dummy = $vit_decode_streaming_block(T_pad, D, B, 0);
+      else
+        dummy = $vit_decode_streaming(T_pad, D, 0);
+
+      // Interleave input bytes and output bytes on the shared uio bus
+      sent = 0; got_bits = 0; errors = 0; idle = 0;
+      while (idle < 4 * (D + B + (1 << TB_K))) begin
+        if (uo_out[1]) begin
+          for (j = 0; j < 8; j = j + 1)
+            if (uio_out[j] !== $vit_get_dec(WARM + got_bits + j)) errors = errors + 1;
+          got_bits = got_bits + 8;
+          ui_in = 8'h10;
+          @(posedge clk); #1;
+          ui_in = 8'h00;
+          idle = 0;
+        end else if (uo_out[0] && sent < T_pad) begin
+          b = 0;
+          for (j = 0; j < 4; j = j + 1) b = b | ($vit_get_sym(sent + j) << (2 * j));
+          uio_in = b; ui_in = 8'h01;
+          @(posedge clk); #1;
+          ui_in = 8'h00;
+          sent = sent + 4;
+          idle = 0;
+        end else begin
+          @(posedge clk); #1;
+          if (sent >= T_pad && !uo_out[3]) idle = idle + 1;
+        end
+      end
+
+      // Every whole byte of the T_pad - WARM decoded bits must have come out
+      if (got_bits != ((T_pad - WARM) / 8) * 8 || errors != 0) begin
+        fails = fails + 1;
+        $display("FAIL stream=%0d n=%0d flips=%0d bits=%0d/%0d errors=%0d", f, n, flips,
+                 got_bits, ((T_pad - WARM) / 8) * 8, errors);
+      end
+      nbits = nbits + got_bits;
+
+      // Restart from state 0 for the next stream
+      ui_in = 8'h08;
+      @(posedge clk); #1;
+      ui_in = 8'h00;
+      while (uo_out[3]) begin @(posedge clk); #1; end
+    end
+
+    $display("K=%0d D=%0d seed=%0d streams=%0d bits=%0d p=%f fails=%0d", TB_K, D, seed,
+             streams, nbits, p_err, fails);
+    if (fails == 0) $display("PASS");
+    $finish;
+  end
+
+endmodule
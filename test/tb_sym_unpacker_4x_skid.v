@@ -0,0 +1,145 @@
+`timescale 1ns/1ps
+
+//=============================================================================
+// sym_unpacker_4x_skid Testbench
+//=============================================================================
+// A source offers bytes (keeping in_valid up until taken) and a sink takes
+// symbols, each with a per-run probability per cycle. Every cycle, with
+// "pending" = 4 x bytes taken - symbols taken, the bench checks
+//   rx_sym_valid == (pending > 0)   no bubble while a taken byte has symbols
+//   in_ready     == (pending <= 4)  the next byte is taken while one drains
+// plus symbol order and rx_sym held while rx_sym_ready is low.
+//
+// Test Coverage:
+//   T0: reset: in_ready high, rx_sym_valid low
+//   T1: continuous valid / ready, bytes 0x00..0xFF: the 1024 symbols must
+//       leave on 1024 consecutive cycles, starting the cycle after the
+//       first byte is taken (sym_unpacker_4x needs 5 cycles per byte)
+//   T2: random valid / ready, 9 source / sink rate pairs of RUN_BYTES
+//       random bytes each
+//=============================================================================
+
+module tb_sym_unpacker_4x_skid;
+
+  parameter RUN_BYTES = 300;
+
+  reg        clk, rst;
+  reg        in_valid;
+  wire       in_ready;
+  reg  [7:0] in_byte;
+  wire       rx_sym_valid;
+  reg        rx_sym_ready;
+  wire [1:0] rx_sym;
+
+  sym_unpacker_4x_skid dut (
+      .clk(clk), .rst(rst), .in_valid(in_valid), .in_ready(in_ready), .in_byte(in_byte),
+      .rx_sym_valid(rx_sym_valid), .rx_sym_ready(rx_sym_ready), .rx_sym(rx_sym)
+  );
+
+  initial begin clk = 0; forever #5 clk = ~clk; end
+
+  reg  [7:0] bytes [0:1023];
+  integer    n_bytes, p_in, p_out;      // current run
+  integer    src_i, snk_i, pending;     // bytes taken, symbols taken
+  integer    cyc, first_sym, last_sym, errors, r;
+  reg        running, held_valid;
+  reg  [1:0] held_sym;
+
+  // Source and sink, sampled on the edge like the DUT
+  always @(posedge clk) begin
+    if (running) begin
+      pending = 4 * src_i - snk_i;
+      if (rx_sym_valid !== (pending > 0) || in_ready !== (pending <= 4)) begin
+        if (errors < 10)
+          $display("FAIL cycle %0d: pending=%0d rx_sym_valid=%b in_ready=%b", cyc,
+                   pending, rx_sym_valid, in_ready);
+        errors = errors + 1;
+      end
+      if (held_valid && rx_sym !== held_sym) begin
+        if (errors < 10) $display("FAIL cycle %0d: rx_sym changed under backpressure", cyc);
+        errors = errors + 1;
+      end
+
+      if (rx_sym_valid && rx_sym_ready) begin
+        if (rx_sym !== bytes[snk_i / 4][2 * (snk_i % 4) +: 2]) begin
+          if (errors < 10)
+            $display("FAIL cycle %0d: symbol %0d = %b, expected %b", cyc, snk_i, rx_sym,
+                     bytes[snk_i / 4][2 * (snk_i % 4) +: 2]);
+          errors = errors + 1;
+        end
+        if (snk_i == 0) first_sym = cyc;
+        last_sym = cyc;
+        snk_i = snk_i + 1;
+      end
+      held_valid = rx_sym_valid && !rx_sym_ready;
+      held_sym   = rx_sym;
+
+      if (in_valid && in_ready) src_i = src_i + 1;
+      if (!(in_valid && !in_ready)) begin
+        in_valid <= src_i < n_bytes && ($urandom % 100) < p_in;
+        in_byte  <= bytes[src_i % 1024];
+      end
+      rx_sym_ready <= ($urandom % 100) < p_out;
+      cyc = cyc + 1;
+    end
+  end
+
+  // Reset, then run n bytes through with the given source / sink rates
+  task run(input integer n, input integer pi, input integer po);
+    begin
+      running = 0;
+      rst = 1; in_valid = 0; in_byte = 0; rx_sym_ready = 0;
+      repeat (2) @(posedge clk);
+      #1 rst = 0;
+      n_bytes = n; p_in = pi; p_out = po;
+      src_i = 0; snk_i = 0; cyc = 0; first_sym = -1; last_sym = -1; held_valid = 0;
+      // First byte and ready go up before the first sampled edge
+      in_valid = (pi >= 100); in_byte = bytes[0]; rx_sym_ready = (po >= 100);
+      running = 1;
+      while (snk_i < 4 * n && cyc < 20 * n + 100) @(posedge clk);
+      #1 running = 0;
+      if (snk_i < 4 * n) begin
+        $display("FAIL timeout: %0d of %0d symbols (p_in=%0d p_out=%0d)", snk_i, 4 * n, pi, po);
+        errors = errors + 1;
+      end
+    end
+  endtask
+
+  initial begin
+    errors = 0; running = 0;
+    rst = 1; in_valid = 0; in_byte = 0; rx_sym_ready = 0;
+    repeat (3) @(posedge clk);
+    #1 rst = 0;
+
+    // T0
+    #1;
+    if (in_ready !== 1'b1 || rx_sym_valid !== 1'b0) begin
+      $display("FAIL reset: in_ready=%b rx_sym_valid=%b", in_ready, rx_sym_valid);
+      errors = errors + 1;
+    end
+
+    // T1: first byte taken on cycle 0, symbols on cycles 1 .. 1024
+    for (r = 0; r < 256; r = r + 1) bytes[r] = r;
+    run(256, 100, 100);
+    if (first_sym != 1 || last_sym != 1024) begin
+      $display("FAIL throughput: symbols on cycles %0d..%0d, expected 1..1024", first_sym,
+               last_sym);
+      errors = errors + 1;
+    end else
+      $display("T1: 1024 symbols in 1024 cycles, no bubbles");
+
+    // T2
+    for (r = 0; r < 9; r = r + 1) begin
+      for (src_i = 0; src_i < RUN_BYTES; src_i = src_i + 1) bytes[src_i] = $random;
+      run(RUN_BYTES, (r / 3 == 0) ? 30 : (r / 3 == 1) ? 70 : 100,
+                     (r % 3 == 0) ? 30 : (r % 3 == 1) ? 70 : 100);
+    end
+
+    if (errors == 0)
+      $display("PASS: sym_unpacker_4x_skid, %0d bytes", 256 + 9 * RUN_BYTES);
+    else
+      $display("FAIL: sym_unpacker_4x_skid, %0d errors", errors);
+    $finish;
+  end
+
+endmodule
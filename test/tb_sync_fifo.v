@@ -0,0 +1,111 @@
+`timescale 1ns/1ps
+
+//=============================================================================
+// sync_fifo Testbench
+//=============================================================================
+// Drives random push / pop patterns into sync_fifo and checks, every cycle,
+// the head entry, all four flags and level against a behavioural queue. The push
+// and pop probabilities change per phase, so the FIFO is run full, empty
+// and in between, with pushes on a full FIFO and pops on an empty one
+// (both must be ignored). Override D with iverilog -P, e.g.
+//   iverilog -g2012 -Ptb_sync_fifo.D=2 ...
+// (Makefile.sync_fifo runs D = 2, 4 and 16.)
+//
+// Test Coverage:
+//   T0: empty after reset: empty, aempty, not full / afull, level 0
+//   T1: random push / pop, PHASES phases of CYCLES cycles, biased towards
+//       filling, draining and balanced traffic in turn
+//   T2: push and pop on the same edge, full and empty included
+//=============================================================================
+
+module tb_sync_fifo;
+
+  parameter W      = 8;
+  parameter D      = 4;
+  parameter CYCLES = 400;
+  parameter PHASES = 6;
+
+  localparam AFULL  = D - D / 4;
+  localparam AEMPTY = D / 4;
+
+  reg          clk, rst;
+  reg          push, pop;
+  reg  [W-1:0] din;
+  wire [W-1:0] dout;
+  wire         empty, full, afull, aempty;
+  wire [$clog2(D):0] level;
+
+  sync_fifo #(.W(W), .D(D)) dut (
+      .clk(clk), .rst(rst), .push(push), .din(din), .pop(pop), .dout(dout),
+      .empty(empty), .full(full), .afull(afull), .aempty(aempty), .level(level)
+  );
+
+  initial begin clk = 0; forever #5 clk = ~clk; end
+
+  // Behavioural queue: entries ref_q[head .. head + count - 1]
+  reg [W-1:0] ref_q [0:D-1];
+  integer     head, count, errors, ph, c, p_push, p_pop, n_both;
+
+  task check(input integer t);
+    begin
+      if (empty !== (count == 0) || full !== (count == D) ||
+          afull !== (count >= AFULL) || aempty !== (count <= AEMPTY) || level !== count ||
+          (count != 0 && dout !== ref_q[head])) begin
+        if (errors < 10)
+          $display("FAIL t=%0d count=%0d empty=%b full=%b afull=%b aempty=%b dout=%h/%h", t,
+                   count, empty, full, afull, aempty, dout, ref_q[head]);
+        errors = errors + 1;
+      end
+    end
+  endtask
+
+  initial begin
+    errors = 0; head = 0; count = 0; n_both = 0;
+    rst = 1; push = 0; pop = 0; din = 0;
+    repeat (3) @(posedge clk);
+    #1 rst = 0;
+
+    // T0
+    check(0);
+
+    // T1 / T2: fill-heavy, drain-heavy and balanced phases
+    for (ph = 0; ph < PHASES; ph = ph + 1) begin
+      p_push = (ph % 3 == 0) ? 80 : (ph % 3 == 1) ? 20 : 50;
+      p_pop  = (ph % 3 == 0) ? 20 : (ph % 3 == 1) ? 80 : 50;
+      for (c = 0; c < CYCLES; c = c + 1) begin
+        push = ($urandom % 100) < p_push;
+        pop  = ($urandom % 100) < p_pop;
+        din  = $random;
+        if (push && pop && count != 0 && count != D) n_both = n_both + 1;
+        @(posedge clk);
+        // Pre-edge count decides what took effect
+        if (pop && count != 0) begin
+          head  = (head + 1) % D;
+          count = count - 1;
+          if (push && count + 1 != D) begin
+            ref_q[(head + count) % D] = din;
+            count = count + 1;
+          end
+        end else if (push && count != D) begin
+          ref_q[(head + count) % D] = din;
+          count = count + 1;
+        end
+        #1;
+        check(ph * CYCLES + c + 1);
+      end
+    end
+    push = 0; pop = 0;
+
+    if (n_both == 0) begin
+      $display("FAIL no cycle pushed and popped together");
+      errors = errors + 1;
+    end
+
+    if (errors == 0)
+      $display("PASS: sync_fifo W=%0d D=%0d, %0d cycles", W, D, PHASES * CYCLES);
+    else
+      $display("FAIL: sync_fifo W=%0d D=%0d, %0d errors", W, D, errors);
+    $finish;
+  end
+
+endmodule
@@ -0,0 +1,213 @@
+// Live random regression of tt_um_ashvin_viterbi against the C golden model.
+// Stimulus and expected output come from viterbi_vpi.c ($vit_* system
+// functions wrapping c-tests/viterbi_golden.c), so no .mem/.hex files are
+// generated or read. Build and run via Makefile.dpi:
+//
+//   make -f Makefile.dpi live TB_K=5 FRAMES=2000 SEED=7 P_ERR=0.02
+//
+// Plusargs: +frames=N +seed=S +p=P (BSC flip probability on coded bits).
+// Clean frames must match exactly. Noisy frames are compared against the
+// C decoder forced to end in state 0, which is what the RTL traces back from.
+// +trunc=1 drops the code tail and closes every frame with TRUNC: the RTL
+// must deliver all T_pad bits of $vit_decode_trunc (best end state). The
+// DUT is built with BEST_SEARCH = 1 for that, which leaves frames closed
+// without TRUNC as they are.
+// TB_SURV_DEPTH != 0 builds the DUT with that SURV_DEPTH and checks it
+// against $vit_decode_window, which windows the traceback the same way.
+// TB_REGX = 1 builds it with REG_EXCHANGE (SURV_DEPTH ignored) and
+// TB_PAIR = 1 with TB_PAIR; the decode must not change. TB_ACS_PIPE = 1
+// builds the pipelined serial ACS (ACS_PAR = 0 only), same decode again.
+// TB_SOFT = Q builds the DUT with SOFT = Q: each frame goes through BPSK
+// over AWGN at +ebn0=X dB (default 20), quantised to Q-bit samples by
+// $vit_awgn_soft, one symbol per byte, and is checked against the soft
+// C decoder ($vit_soft); +p is ignored.
+`timescale 1ns/1ps
+
+module tb_top_live();
+
+`ifndef TB_K
+  `define TB_K 5
+`endif
+
+`ifndef TB_ACS_PAR
+  `define TB_ACS_PAR 0
+`endif
+
+`ifndef TB_ACS_PIPE
+  `define TB_ACS_PIPE 0
+`endif
+
+`ifndef TB_RADIX
+  `define TB_RADIX 2
+`endif
+
+`ifndef TB_CUT
+  `define TB_CUT 0
+`endif
+
+`ifndef TB_OUT_MODE
+  `define TB_OUT_MODE 0
+`endif
+
+`ifndef TB_MAX_FRAME
+  `define TB_MAX_FRAME 32
+`endif
+
+`ifndef TB_SURV_DEPTH
+  `define TB_SURV_DEPTH 0
+`endif
+
+`ifndef TB_REGX
+  `define TB_REGX 0
+`endif
+
+`ifndef TB_PAIR
+  `define TB_PAIR 0
+`endif
+
+`ifndef TB_SOFT
+  `define TB_SOFT 0
+`endif
+
+  localparam TB_K = `TB_K;
+  localparam TB_G0 = (TB_K == 3) ? 'o7  :
+                     (TB_K == 5) ? 'o23 :
+                     (TB_K == 7) ? 'o171 : 'o23;
+  localparam TB_G1 = (TB_K == 3) ? 'o5  :
+                     (TB_K == 5) ? 'o35 :
+                     (TB_K == 7) ? 'o133 : 'o35;
+  localparam MAX_FRAME = `TB_MAX_FRAME;
+  localparam SURV_DEPTH = `TB_REGX ? 0 : `TB_SURV_DEPTH;
+  localparam SOFT = `TB_SOFT;
+  localparam SPB  = SOFT ? 1 : 4;     // symbols per input byte
+
+  reg  [7:0] ui_in;
+  wire [7:0] uo_out;
+  reg  [7:0] uio_in;
+  wire [7:0] uio_out;
+  wire [7:0] uio_oe;
+  reg        clk, rst_n;
+
+  initial begin clk = 0; forever #5 clk = ~clk; end
+
+  tt_um_ashvin_viterbi #(.K(TB_K), .G0_OCT(TB_G0), .G1_OCT(TB_G1), .ACS_PAR(`TB_ACS_PAR),
+                       .ACS_PIPE(`TB_ACS_PIPE), .RADIX(`TB_RADIX), .CUT_THROUGH(`TB_CUT),
+                       .OUT_MODE(`TB_OUT_MODE), .MAX_FRAME(MAX_FRAME),
+                       .SURV_DEPTH(SURV_DEPTH), .REG_EXCHANGE(`TB_REGX),
+                       .TB_PAIR(`TB_PAIR), .SOFT(SOFT), .BEST_SEARCH(1)) dut (
+    .ui_in(ui_in), .uo_out(uo_out), .uio_in(uio_in), .uio_out(uio_out),
+    .uio_oe(uio_oe), .ena(1'b1), .clk(clk), .rst_n(rst_n)
+  );
+
+  integer frames, seed, f, i, j, n, T, T_pad, flips, errors, timeout, fails, nbits;
+  integer dummy, pos, trunc, nout;
+  real    p_err, ebn0;
+  reg [7:0] b;
+  reg       got [0:MAX_FRAME-1];
+
+  task send_byte(input [7:0] value);
+    begin
+      timeout = 0;
+      while (!uo_out[0] && timeout < 1000) begin @(posedge clk); #1; timeout = timeout + 1; end
+      uio_in = value; ui_in = 8'h01;
+      @(posedge clk); #1;
+      ui_in = 8'h00;
+    end
+  endtask
+
+  task pulse(input [7:0] bits);
+    begin
+      ui_in = bits;
+      @(posedge clk); #1;
+      ui_in = 8'h00;
+    end
+  endtask
+
+  initial begin
+    if (!$value$plusargs("frames=%d", frames)) frames = 500;
+    if (!$value$plusargs("seed=%d", seed))     seed   = 1;
+    if (!$value$plusargs("p=%f", p_err))       p_err  = 0.0;
+    if (!$value$plusargs("trunc=%d", trunc))   trunc  = 0;
+    if (!$value$plusargs("ebn0=%f", ebn0))     ebn0   = 20.0;
+
+    if ($vit_k() != TB_K) begin
+      $display("FAIL: VPI library built for K=%0d, bench is K=%0d", $vit_k(), TB_K);
+      $finish;
+    end
+    dummy = $vit_seed(seed);
+    dummy = $vit_soft(SOFT);
+
+    ui_in = 0; uio_in = 0; rst_n = 0;
+    repeat (5) @(posedge clk);
+    #1 rst_n = 1;
+    repeat (2) @(posedge clk);
+    #1;
+
+    fails = 0; nbits = 0;
+    for (f = 0; f < frames; f = f + 1) begin
+      // Random frame, zero-padded to whole bytes: 00 symbols keep the
+      // encoder in state 0 after the tail, so padding does not change the decode.
+      // A truncated frame is the first n symbols only, no tail.
+      n = 1 + ($unsigned($random) % (trunc ? MAX_FRAME : MAX_FRAME - TB_K + 1));
+      dummy = $vit_rand_bits(n);
+      T = $vit_encode(n);
+      if (trunc) T = n;
+      T_pad = SOFT ? T : (T + 3) & ~3;
+      for (i = T; i < T_pad; i = i + 1) dummy = $vit_set_sym(i, 0);
+      flips = SOFT ? $vit_awgn_soft(T_pad, ebn0) : (p_err > 0.0) ? $vit_bsc(T_pad, p_err) : 0;
+      if (SURV_DEPTH != 0) begin
+        dummy = $vit_decode_window(T_pad, SURV_DEPTH, trunc);
+        nout  = trunc ? T_pad : n;
+      end else begin
+        nout = trunc ? $vit_decode_trunc(T_pad) : n;
+        if (!trunc) dummy = $vit_decode(T_pad, 0);
+      end
+
+      for (i = 0; i < T_pad; i = i + SPB) begin
+        b = 0;
+        if (SOFT) b = $vit_get_sym(i);
+        else for (j = 0; j < 4; j = j + 1) b = b | ($vit_get_sym(i + j) << (2 * j));
+        send_byte(b);
+      end
+      pulse(trunc ? 8'h0A : 8'h08);
+
+      // Drain until frame_done
+      i = 0; timeout = 0;
+      while (!uo_out[4] && timeout < 20000) begin
+        if (uo_out[1]) begin
+          // OUT_MODE 2 sends the highest byte first
+          pos = (`TB_OUT_MODE == 2) ? (((trunc ? T_pad : T_pad - TB_K + 1) - 1) / 8) * 8 - i : i;
+          for (j = 0; j < 8; j = j + 1)
+            if (pos >= 0 && pos + j < MAX_FRAME) got[pos + j] = uio_out[j];
+          i = i + 8;
+          pulse(8'h10);
+          timeout = 0;
+        end else begin
+          @(posedge clk); #1;
+          timeout = timeout + 1;
+        end
+      end
+      pulse(8'h08);
+
+      errors = 0;
+      for (j = 0; j < nout; j = j + 1)
+        if (j >= i || got[j] !== $vit_get_dec(j)) errors = errors + 1;
+      nbits = nbits + nout;
+
+      if (timeout >= 20000 || errors != 0) begin
+        fails = fails + 1;
+        $display("FAIL frame=%0d n=%0d flips=%0d errors=%0d%s", f, n, flips, errors,
+                 (timeout >= 20000) ? " timeout" : "");
+      end
+    end
+
+    if (SOFT)
+      $display("K=%0d SOFT=%0d seed=%0d frames=%0d bits=%0d ebn0=%f fails=%0d", TB_K, SOFT, seed,
+               frames, nbits, ebn0, fails);
+    else
+      $display("K=%0d seed=%0d frames=%0d bits=%0d p=%f fails=%0d", TB_K, seed, frames, nbits, p_err, fails);
+    if (fails == 0) $display("PASS");
+    $finish;
+  end
+
+endmodule
@@ -0,0 +1,234 @@
+// tb_top_verilator.cpp
+// High-speed regression harness for tt_um_ashvin_viterbi under Verilator.
+//
+// Reads binary golden-vector files (c-tests/golden_vectors.h, produced and
+// cached by golden_cache.py), drives every frame through the UART byte
+// protocol and compares the decoded bits against the C golden model.
+//
+// Usage:
+//   Vtt_um_ashvin_viterbi [-q] [--csv out.csv] [--limit N] vectors.bin...
+//
+// Prints one line per failing frame (every frame without -q) and a summary,
+// which includes the wall-clock time and frames decoded per second.
+// Noisy frames are only reported as mismatches, like test_viterbi_noise_resilience
+// in test.py: the RTL traces back from state 0 while the C model picks the best
+// end state. Exit status is non-zero if any clean frame fails.
+// --check-model also runs every frame through the C++ FSM model
+// (c-tests/fsm_model.h) with the same host timing and reports any frame whose
+// cycle counts differ from the RTL, so the performance model stays honest.
+// TB_NBUF = 2 builds against a ping-pong top: each frame is a one-frame
+// TopDriver::run_chain(), so decode is not timed separately.
+// TB_SOFT = Q builds against a SOFT = Q top: each hard symbol is sent as two
+// full-scale Q-bit samples, one symbol per byte, so frames keep their odd
+// lengths and decode exactly as the hard golden model.
+// Build and parallel runs: see Makefile.verilator.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Vtt_um_ashvin_viterbi.h"
+#include "verilated.h"
+
+#include "fsm_model.h"
+#include "golden_vectors.h"
+#include "top_driver.h"
+
+#ifndef TB_K
+#define TB_K 5
+#endif
+#ifndef TB_ACS_PAR
+#define TB_ACS_PAR 0
+#endif
+#ifndef TB_ACS_PIPE
+#define TB_ACS_PIPE 0
+#endif
+#ifndef TB_RADIX
+#define TB_RADIX 2
+#endif
+#ifndef TB_CUT
+#define TB_CUT 0
+#endif
+#ifndef TB_OUT_MODE
+#define TB_OUT_MODE 0
+#endif
+#ifndef TB_NBUF
+#define TB_NBUF 1
+#endif
+#ifndef TB_SOFT
+#define TB_SOFT 0
+#endif
+
+struct Stats {
+    uint64_t frames = 0, clean_fail = 0, noisy_mismatch = 0, timeouts = 0;
+    uint64_t cycles = 0, bits = 0;
+    uint64_t model_mismatch = 0;
+};
+
+using ModelDriver = topdrv::TopDriver<fsmmodel::FsmModel>;
+
+static bool run_file(const char *path, topdrv::TopDriver<Vtt_um_ashvin_viterbi> &drv,
+                     ModelDriver *model, Stats &st, FILE *csv, bool quiet, uint64_t limit) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) { perror(path); return false; }
+    struct stat sb;
+    if (fstat(fd, &sb) != 0) { perror(path); close(fd); return false; }
+    void *map = mmap(nullptr, (size_t)sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) { perror(path); return false; }
+
+    const uint8_t *base = static_cast<const uint8_t *>(map);
+    gv_header_t h;
+    if (gv_parse_header(base, (size_t)sb.st_size, &h) != 0) {
+        fprintf(stderr, "%s: not a golden vector file\n", path);
+        munmap(map, (size_t)sb.st_size);
+        return false;
+    }
+    if (h.k != TB_K) {
+        fprintf(stderr, "%s: vectors are K=%u, model is K=%d\n", path, h.k, TB_K);
+        munmap(map, (size_t)sb.st_size);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < h.num_tests && st.frames < limit; ++i) {
+        gv_record_t rec;
+        gv_get_record(base, &h, i, &rec);
+        std::string name(rec.name, strnlen(rec.name, GV_NAME_LEN));
+
+        // SOFT: {g0, g1} -> {g0 ? 2^Q-1 : 0, g1 ? 2^Q-1 : 0}
+        std::vector<uint8_t> soft_syms;
+        const uint8_t *syms = rec.symbols;
+        if (TB_SOFT) {
+            const unsigned one = (1u << TB_SOFT) - 1u;
+            for (int t = 0; t < rec.num_symbols; ++t)
+                soft_syms.push_back((uint8_t)((((rec.symbols[t] >> 1) & 1u) * one) << TB_SOFT |
+                                              (rec.symbols[t] & 1u) * one));
+            syms = soft_syms.data();
+        }
+
+        topdrv::FrameResult r = TB_NBUF == 2 ? drv.run_chain(syms, rec.num_symbols, 1)
+                                             : drv.run_frame(syms, rec.num_symbols);
+        int errors = 0;
+        if (!r.ok) {
+            ++st.timeouts;
+            drv.reset();
+        } else {
+            for (int b = 0; b < rec.num_decoded; ++b)
+                if (b >= (int)r.bits.size() || r.bits[b] != rec.decoded[b]) ++errors;
+        }
+        bool pass = r.ok && errors == 0;
+
+        if (model) {
+            topdrv::FrameResult mr = TB_NBUF == 2 ? model->run_chain(syms, rec.num_symbols, 1)
+                                                  : model->run_frame(syms, rec.num_symbols);
+            if (r.ok && (!mr.ok || mr.cycles != r.cycles || mr.decode_cycles != r.decode_cycles)) {
+                ++st.model_mismatch;
+                printf("MODEL seed=%u %-24s rtl=%llu/%llu model=%llu/%llu\n", h.seed, name.c_str(),
+                       (unsigned long long)r.cycles, (unsigned long long)r.decode_cycles,
+                       (unsigned long long)mr.cycles, (unsigned long long)mr.decode_cycles);
+            }
+            if (!r.ok) model->reset();
+        }
+
+        ++st.frames;
+        st.cycles += r.cycles;
+        st.bits += (uint64_t)rec.num_data_bits;
+        if (!pass) {
+            if (rec.noisy && r.ok) ++st.noisy_mismatch;
+            else ++st.clean_fail;
+        }
+
+        if (!quiet || !pass)
+            printf("%s seed=%u %-24s %s errors=%d cycles=%llu decode=%llu\n",
+                   pass ? "PASS" : (rec.noisy && r.ok ? "DIFF" : "FAIL"),
+                   h.seed, name.c_str(), r.ok ? "" : "timeout", errors,
+                   (unsigned long long)r.cycles, (unsigned long long)r.decode_cycles);
+        if (csv)
+            fprintf(csv, "%u,%s,%d,%d,%d,%d,%llu,%llu\n", h.seed, name.c_str(),
+                    rec.noisy, rec.num_symbols, pass, errors,
+                    (unsigned long long)r.cycles, (unsigned long long)r.decode_cycles);
+    }
+
+    munmap(map, (size_t)sb.st_size);
+    return true;
+}
+
+int main(int argc, char **argv) {
+    const auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
+
+    bool quiet = false, check_model = false;
+    const char *csv_path = nullptr;
+    uint64_t limit = UINT64_MAX;
+    std::vector<const char *> files;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "-q")) quiet = true;
+        else if (!strcmp(argv[i], "--check-model")) check_model = true;
+        else if (!strcmp(argv[i], "--csv") && i + 1 < argc) csv_path = argv[++i];
+        else if (!strcmp(argv[i], "--limit") && i + 1 < argc) limit = strtoull(argv[++i], nullptr, 0);
+        else if (argv[i][0] == '+') continue;  // Verilator plusargs
+        else files.push_back(argv[i]);
+    }
+    if (files.empty()) {
+        fprintf(stderr, "usage: %s [-q] [--check-model] [--csv out.csv] [--limit N] vectors.bin...\n", argv[0]);
+        return 2;
+    }
+
+    FILE *csv = nullptr;
+    if (csv_path) {
+        csv = fopen(csv_path, "w");
+        if (!csv) { perror(csv_path); return 2; }
+        fprintf(csv, "seed,name,noisy,symbols,pass,errors,cycles,decode_cycles\n");
+    }
+
+    const auto top = std::make_unique<Vtt_um_ashvin_viterbi>(ctx.get());
+    topdrv::TopDriver<Vtt_um_ashvin_viterbi> drv(top.get());
+    drv.set_last_byte_first(TB_OUT_MODE == 2);
+    drv.set_soft(TB_SOFT);
+    drv.reset();
+
+    fsmmodel::Config mcfg;
+    mcfg.k = TB_K;
+    mcfg.acs_par = TB_ACS_PAR;
+    mcfg.acs_pipe = TB_ACS_PIPE != 0;
+    mcfg.radix = TB_RADIX;
+    mcfg.cut_through = TB_CUT != 0;
+    mcfg.out_mode = TB_OUT_MODE;
+    mcfg.nbuf = TB_NBUF;
+    mcfg.soft = TB_SOFT;
+    fsmmodel::FsmModel fsm(mcfg);
+    ModelDriver mdrv(&fsm);
+    mdrv.set_soft(TB_SOFT);
+    mdrv.reset();
+
+    Stats st;
+    bool io_ok = true;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (const char *f : files)
+        io_ok &= run_file(f, drv, check_model ? &mdrv : nullptr, st, csv, quiet, limit);
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    top->final();
+    if (csv) fclose(csv);
+
+    printf("K=%d frames=%llu clean_fail=%llu noisy_mismatch=%llu timeouts=%llu "
+           "cycles=%llu cycles/bit=%.2f",
+           TB_K, (unsigned long long)st.frames, (unsigned long long)st.clean_fail,
+           (unsigned long long)st.noisy_mismatch, (unsigned long long)st.timeouts,
+           (unsigned long long)st.cycles,
+           st.bits ? (double)st.cycles / (double)st.bits : 0.0);
+    if (check_model) printf(" model_mismatch=%llu", (unsigned long long)st.model_mismatch);
+    printf(" wall=%.3fs frames/s=%.0f\n", wall, wall > 0 ? (double)st.frames / wall : 0.0);
+
+    return (io_ok && st.clean_fail == 0 && st.model_mismatch == 0) ? 0 : 1;
+}
@@ -4,15 +4,19 @@
 import cocotb
 from cocotb.triggers import ClockCycles, RisingEdge
 import os
-import subprocess
-import json
-import tempfile
+
+import golden_cache
 
 GL_TEST = os.environ.get('GATES', 'no') == 'yes'
 TIMEOUT_MULT = 100 if GL_TEST else 1
 
 # Determine K from TB_K compile arg (default 5)
 TB_K = int(os.environ.get('TB_K', '5'))
+# BEST_SEARCH=1 build (make BEST_SEARCH=1): TRUNC frames keep all their bits
+BEST_SEARCH = os.environ.get('BEST_SEARCH', '0') == '1'
+# SOFT=Q build (make SOFT=3): one symbol per byte, full-scale Q-bit samples
+SOFT = int(os.environ.get('SOFT', '0'))
+MAX_FRAME = 32
 
 _golden_cache = {}
 
@@ -95,6 +99,15 @@ def pack_symbols_to_byte(symbols):
            ((symbols[2] & 0x3) << 4) | ((symbols[3] & 0x3) << 6)
 
 
+def pack_frame(symbols):
+    """Input bytes of a frame: 4 packed symbols per byte, or with SOFT one
+    symbol per byte as {g0, g1} samples of 0 or 2^Q - 1."""
+    if SOFT:
+        one = (1 << SOFT) - 1
+        return [(((s >> 1) & 1) * one) << SOFT | (s & 1) * one for s in symbols]
+    return [pack_symbols_to_byte(symbols[i:i+4]) for i in range(0, len(symbols), 4)]
+
+
 def safe_int(val):
     """Safely convert LogicArray to int, treating X/Z as 0"""
     try:
@@ -123,10 +136,7 @@ async def run_uart_decode_test(dut, test_bits, test_name):
     dut._log.info(f"{test_name}: {len(test_bits)} bits -> {len(symbols)} symbols (K={TB_K})")
 
     # Pack symbols into bytes
-    symbol_bytes = []
-    for i in range(0, len(symbols), 4):
-        chunk = symbols[i:i+4]
-        symbol_bytes.append(pack_symbols_to_byte(chunk))
+    symbol_bytes = pack_frame(symbols)
 
     # Feed symbol bytes
     for i, sym_byte in enumerate(symbol_bytes):
@@ -201,8 +211,10 @@ async def run_uart_decode_test(dut, test_bits, test_name):
     return decoded, errors
 
 
-async def run_uart_decode_test_with_symbols(dut, symbols, expected_num_data_bits, test_name):
+async def run_uart_decode_test_with_symbols(dut, symbols, expected_num_data_bits, test_name,
+                                            start_ui=0x08):
     """Run decode test using pre-encoded symbols (for golden vector testing).
+    start_ui is the ui_in value of the START cycle (0x0A adds TRUNC).
     Returns decoded bits list. Caller handles comparison."""
     clk = dut.clk
 
@@ -218,10 +230,7 @@ async def run_uart_decode_test_with_symbols(dut, symbols, expected_num_data_bits
     dut._log.info(f"{test_name}: {expected_num_data_bits} data bits, {len(symbols)} symbols (K={TB_K})")
 
     # Pack symbols into bytes
-    symbol_bytes = []
-    for i in range(0, len(symbols), 4):
-        chunk = symbols[i:i+4]
-        symbol_bytes.append(pack_symbols_to_byte(chunk))
+    symbol_bytes = pack_frame(symbols)
 
     # Feed symbol bytes
     for i, sym_byte in enumerate(symbol_bytes):
@@ -245,7 +254,7 @@ async def run_uart_decode_test_with_symbols(dut, symbols, expected_num_data_bits
     await ClockCycles(clk, 20)
 
     # Start decode
-    dut.ui_in.value = 0x08
+    dut.ui_in.value = start_ui
     await RisingEdge(clk)
     dut.ui_in.value = 0
     await ClockCycles(clk, 5)
@@ -295,38 +304,10 @@ async def run_uart_decode_test_with_symbols(dut, symbols, expected_num_data_bits
 
 
 def get_golden_vectors():
-    """Compile and run C golden vector generator, return parsed JSON."""
-    if TB_K in _golden_cache:
-        return _golden_cache[TB_K]
-
-    k_config = {
-        3: {'g0': '07', 'g1': '05'},
-        5: {'g0': '023', 'g1': '035'},
-        7: {'g0': '0171', 'g1': '0133'},
-    }
-    cfg = k_config[TB_K]
-
-    src = os.path.join(os.path.dirname(__file__), '..', 'c-tests', 'gen_golden_vectors.c')
-    golden_src = os.path.join(os.path.dirname(__file__), '..', 'c-tests', 'viterbi_golden.c')
-
-    with tempfile.NamedTemporaryFile(suffix='.bin', delete=False) as f:
-        binpath = f.name
-
-    # Compile
-    cmd = [
-        'gcc', '-O2', f'-DK={TB_K}', f'-DG0_OCT={cfg["g0"]}', f'-DG1_OCT={cfg["g1"]}',
-        '-I' + os.path.join(os.path.dirname(__file__), '..', 'c-tests'),
-        src, '-o', binpath, '-lm'
-    ]
-    subprocess.run(cmd, check=True)
-
-    # Run and capture JSON
-    result = subprocess.run([binpath], capture_output=True, text=True, check=True)
-    os.unlink(binpath)
-
-    data = json.loads(result.stdout)
-    _golden_cache[TB_K] = data
-    return data
+    """Return the C golden vectors for TB_K from the on-disk cache (see golden_cache.py)."""
+    if TB_K not in _golden_cache:
+        _golden_cache[TB_K] = golden_cache.get_vectors(TB_K, max_frame=MAX_FRAME)
+    return _golden_cache[TB_K]
 
 
 @cocotb.test()
@@ -406,6 +387,21 @@ async def test_viterbi_max_frame(dut):
     dut._log.info("=== TEST PASSED ===")
 
 
+@cocotb.test()
+async def test_viterbi_odd_frame(dut):
+    """Frames of an odd number of symbols. They only stay odd with SOFT (one
+    symbol per byte); RADIX=4 then decodes the last one as a radix-2 step."""
+    M = TB_K - 1
+    base = [1, 1, 0, 1, 0, 0, 1, 0]
+    for n_data in (7 + M % 2, MAX_FRAME - 1 - M):
+        test_bits = (base * ((n_data + 7) // 8))[:n_data]
+        dut._log.info(f"=== K={TB_K} Odd Frame Test: {n_data + M} symbols ===")
+        decoded, errors = await run_uart_decode_test(dut, test_bits, f"odd-{n_data + M}")
+        if errors > 0:
+            raise AssertionError(f"Odd frame of {n_data + M} symbols failed: {errors} errors")
+    dut._log.info("=== ODD FRAME TEST PASSED ===")
+
+
 @cocotb.test()
 async def test_viterbi_golden_comparison(dut):
     """Test Viterbi decoder against C golden reference on 25 patterns."""
@@ -470,6 +466,67 @@ async def test_viterbi_noise_resilience(dut):
     dut._log.info("=== NOISE RESILIENCE TEST DONE ===")
 
 
+@cocotb.test(skip=not BEST_SEARCH)
+async def test_viterbi_truncated_frame(dut):
+    """Frame without the code tail, closed with TRUNC: every bit comes back."""
+    dut._log.info(f"=== K={TB_K} Truncated Frame Test ===")
+    test_bits = [1, 1, 0, 1, 0, 0, 1, 0, 1, 1, 1, 0, 0, 1, 0, 1]
+    symbols = encode(test_bits)[:len(test_bits)]  # drop the tail
+    decoded = await run_uart_decode_test_with_symbols(dut, symbols, len(test_bits), "truncated",
+                                                      start_ui=0x0A)
+    errors = sum(1 for a, b in zip(test_bits, decoded) if a != b)
+    errors += abs(len(test_bits) - len(decoded))
+    if errors > 0:
+        raise AssertionError(f"Truncated decode failed: expected {test_bits}, got {decoded}")
+    dut._log.info("=== TRUNCATED FRAME TEST PASSED ===")
+
+
+@cocotb.test(skip=TB_K < 5)
+async def test_viterbi_tail_only_frame(dut):
+    """One-byte frame no longer than the tail (K >= 5): DONE with no output byte."""
+    dut._log.info(f"=== K={TB_K} Tail-Only Frame Test ===")
+    clk = dut.clk
+
+    dut.rst_n.value = 0
+    dut.ui_in.value = 0
+    dut.uio_in.value = 0
+    dut.ena.value = 1
+    await ClockCycles(clk, 20 * TIMEOUT_MULT)
+    dut.rst_n.value = 1
+    await ClockCycles(clk, 50 * TIMEOUT_MULT)
+
+    # 4 symbols (1 with SOFT) <= M: frame_len - M used to wrap and drain stale out_buf bytes
+    dut.uio_in.value = pack_symbols_to_byte([0, 0, 0, 0])
+    dut.ui_in.value = 0x01
+    await RisingEdge(clk)
+    dut.ui_in.value = 0
+    await ClockCycles(clk, 5)
+    dut.ui_in.value = 0x08
+    await RisingEdge(clk)
+    dut.ui_in.value = 0
+
+    out_bytes = 0
+    for _ in range(2000 * TIMEOUT_MULT):
+        await RisingEdge(clk)
+        uo = safe_int(dut.uo_out.value)
+        if (uo >> 1) & 0x1:  # byte_out_valid
+            out_bytes += 1
+            dut.ui_in.value = 0x10
+            await RisingEdge(clk)
+            dut.ui_in.value = 0
+        elif uo & 0x10:  # frame_done
+            break
+    else:
+        raise AssertionError("Timeout waiting for DONE")
+
+    if out_bytes:
+        raise AssertionError(f"Tail-only frame emitted {out_bytes} output bytes, expected none")
+    dut.ui_in.value = 0x08
+    await RisingEdge(clk)
+    dut.ui_in.value = 0
+    dut._log.info("=== TAIL-ONLY FRAME TEST PASSED ===")
+
+
 @cocotb.test()
 async def test_viterbi_back_to_back(dut):
     """Test back-to-back decoding without reset between frames."""
@@ -497,10 +554,7 @@ async def test_viterbi_back_to_back(dut):
         dut._log.info(f"Frame {idx}: {len(test_bits)} data bits -> {len(symbols)} symbols")
 
         # Pack and send symbols
-        symbol_bytes = []
-        for i in range(0, len(symbols), 4):
-            chunk = symbols[i:i+4]
-            symbol_bytes.append(pack_symbols_to_byte(chunk))
+        symbol_bytes = pack_frame(symbols)
 
         for i, sym_byte in enumerate(symbol_bytes):
             timeout = 0
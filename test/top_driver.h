@@ -0,0 +1,371 @@
+// top_driver.h
+// Cycle-level driver for the tt_um_ashvin_viterbi UART byte protocol on a
+// Verilated model. Shared by the Verilator regression harness
+// (tb_top_verilator.cpp) and anything else that needs to push frames through
+// the top-level without cocotb.
+//
+// Protocol (see docs/info.md):
+//   ui_in[0]  BYTE_VALID   uo_out[0] BYTE_IN_READY
+//   ui_in[1]  TRUNC        (with START: frame has no tail)
+//   ui_in[2]  TBITE        (with START: tail-biting frame)
+//   ui_in[3]  START        uo_out[1] BYTE_OUT_VALID
+//   ui_in[4]  READ_ACK     uo_out[3] BUSY
+//   ui_in[7:5] CHANNEL     uo_out[4] DONE
+//                          uo_out[7:5] channel of the output byte (NCTX)
+//   uio_in  = 4 packed 2-bit symbols, symbol i in bits [2i+1:2i]
+//             (SOFT = Q: one symbol per byte, two Q-bit samples;
+//              PUNCT: the kept bits / samples only, see punct.h)
+//   uio_out = 8 decoded bits, bit i = i-th decoded bit of the byte
+//
+// run_frame() is the single-buffer protocol (receive, START, drain until
+// DONE, START). run_chain() is the NBUF = 2 one: frames are queued back to
+// back with one START each while output bytes are drained as they appear.
+// run_channels() is the NCTX one: several channels' frames interleaved byte
+// by byte on the same pins.
+
+#ifndef TOP_DRIVER_H
+#define TOP_DRIVER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "../c-tests/punct.h"
+
+namespace topdrv {
+
+enum : uint8_t {
+    UI_BYTE_VALID = 1u << 0,
+    UI_TRUNC      = 1u << 1,
+    UI_TBITE      = 1u << 2,
+    UI_START      = 1u << 3,
+    UI_READ_ACK   = 1u << 4,
+
+    UO_IN_READY   = 1u << 0,
+    UO_OUT_VALID  = 1u << 1,
+    UO_BUSY       = 1u << 3,
+    UO_DONE       = 1u << 4,
+
+    CHAN_SHIFT    = 5,        // ui_in[7:5] / uo_out[7:5]
+};
+
+// Host-side handshake timing, in clock cycles.
+struct Timing {
+    unsigned byte_gap  = 0;   // idle cycles after each input byte
+    unsigned start_gap = 0;   // idle cycles between last byte and START
+    unsigned ack_delay = 0;   // cycles BYTE_OUT_VALID is held before READ_ACK
+    unsigned jitter    = 0;   // run_chain(): each byte_gap / ack_delay is
+                              // drawn from its value +- jitter
+};
+
+// OUT_MODE 2 sends a frame's bytes last byte first: put them back in order.
+inline void reverse_byte_order(std::vector<uint8_t> &bits) {
+    std::vector<uint8_t> out;
+    out.reserve(bits.size());
+    for (size_t i = bits.size(); i >= 8; i -= 8)
+        out.insert(out.end(), bits.begin() + (long)(i - 8), bits.begin() + (long)i);
+    bits.swap(out);
+}
+
+struct FrameResult {
+    bool                 ok = false;      // protocol completed without timeout
+    uint64_t             cycles = 0;      // first byte offered .. back in S_IDLE
+    uint64_t             decode_cycles = 0; // START .. first output byte
+    std::vector<uint8_t> bits;            // every decoded bit the DUT emitted
+};
+
+template <class Top>
+class TopDriver {
+public:
+    explicit TopDriver(Top *top, uint64_t timeout = 100000)
+        : top_(top), timeout_(timeout) {}
+
+    uint64_t cycle() const { return cycle_; }
+
+    // run_frame() reorders the bytes of each frame (OUT_MODE 2)
+    void set_last_byte_first(bool on) { last_byte_first_ = on; }
+    // Frames are closed with TRUNC: decoded from the best end state, all
+    // symbols' bits delivered (BEST_SEARCH = 1)
+    void set_trunc(bool on) { trunc_ = on; }
+    // Frames are closed with TBITE: tail-biting, all symbols' bits delivered
+    // (TAIL_BITE != 0)
+    void set_tbite(bool on) { tbite_ = on; }
+    // SOFT = q top: each symbol is two q-bit samples, one symbol per byte
+    // instead of four
+    void set_soft(int q) { soft_ = q; }
+    // PUNCT = p top: only the bits / samples pattern p keeps are sent
+    void set_punct(int p) { punct_ = p; }
+    // run_chain() sends input before reading output: with a byte due and
+    // BYTE_OUT_VALID up it raises BYTE_VALID (uio not driven) to ask an
+    // OUT_FIFO top for the pins, and reads the byte if they stay taken
+    void set_input_first(bool on) { input_first_ = on; }
+    // Input bytes run_chain() sent on pins it had asked for
+    uint64_t granted() const { return granted_; }
+    Top     *top()   const { return top_; }
+
+    void tick() {
+        top_->clk = 0;
+        top_->eval();
+        top_->clk = 1;
+        top_->eval();
+        ++cycle_;
+    }
+
+    void idle(unsigned n) {
+        for (unsigned i = 0; i < n; ++i) tick();
+    }
+
+    void reset() {
+        top_->ena    = 1;
+        top_->ui_in  = 0;
+        top_->uio_in = 0;
+        top_->rst_n  = 0;
+        idle(5);
+        top_->rst_n  = 1;
+        idle(2);
+    }
+
+    uint8_t status() const { return top_->uo_out; }
+
+    // Wait for BYTE_IN_READY, then present the byte for one cycle, together
+    // with any extra ui_in bits (e.g. UI_START on the same edge).
+    bool send_byte(uint8_t b, uint8_t extra_ui = 0) {
+        if (!wait_for(UO_IN_READY)) return false;
+        top_->uio_in = b;
+        top_->ui_in  = (uint8_t)(UI_BYTE_VALID | extra_ui);
+        tick();
+        top_->ui_in  = 0;
+        return true;
+    }
+
+    void pulse(uint8_t ui_bits) {
+        top_->ui_in = ui_bits;
+        tick();
+        top_->ui_in = 0;
+    }
+
+    // Push one frame of symbols through receive, decode and drain.
+    FrameResult run_frame(const uint8_t *syms, int num_syms, const Timing &tm = Timing()) {
+        FrameResult r;
+        const uint64_t t0 = cycle_;
+
+        for (uint8_t b : pack_frame(syms, num_syms)) {
+            if (!send_byte(b)) return r;
+            idle(tm.byte_gap);
+        }
+        idle(tm.start_gap);
+
+        pulse(close_bits());
+        const uint64_t t_start = cycle_;
+
+        // Drain bytes until DONE
+        uint64_t waited = 0;
+        while (!(status() & UO_DONE)) {
+            if (status() & UO_OUT_VALID) {
+                if (r.bits.empty()) r.decode_cycles = cycle_ - t_start;
+                uint8_t b = top_->uio_out;
+                for (int k = 0; k < 8; ++k) r.bits.push_back((b >> k) & 1u);
+                idle(tm.ack_delay);
+                pulse(UI_READ_ACK);
+                waited = 0;
+            } else {
+                tick();
+                if (++waited > timeout_) return r;
+            }
+        }
+
+        // START returns the FSM from S_OUTPUT to S_IDLE
+        pulse(UI_START);
+        if (last_byte_first_) reverse_byte_order(r.bits);
+        r.cycles = cycle_ - t0;
+        r.ok = true;
+        return r;
+    }
+
+    // Push `frames` copies of one frame through a ping-pong (NBUF = 2) top:
+    // each frame's bytes then START, output read whenever BYTE_OUT_VALID is
+    // up (it has priority, uio is shared), until every frame is sent and
+    // DONE. cycles covers the whole run; decode_cycles is unused. A host
+    // with tm.jitter idles a pseudo-random time around each gap: the n-th
+    // byte gap and the n-th ack delay are the same on every run. With
+    // set_input_first() input bytes go ahead of output bytes instead.
+    FrameResult run_chain(const uint8_t *syms, int num_syms, int frames,
+                          const Timing &tm = Timing()) {
+        FrameResult r;
+        const uint64_t t0 = cycle_;
+        const std::vector<uint8_t> bytes = pack_frame(syms, num_syms);
+        int sent_frames = 0;
+        size_t pos = 0;
+        uint64_t waited = 0;
+        uint32_t rng_in = 1, rng_out = 2;
+        bool asked = false;
+
+        while (sent_frames < frames || !(status() & UO_DONE)) {
+            if (input_first_ && !asked && sent_frames < frames && pos < bytes.size() &&
+                (status() & UO_OUT_VALID)) {
+                pulse(UI_BYTE_VALID);
+                asked = true;
+            } else if (status() & UO_OUT_VALID) {
+                asked = false;
+                uint8_t b = top_->uio_out;
+                for (int k = 0; k < 8; ++k) r.bits.push_back((b >> k) & 1u);
+                idle(vary(tm.ack_delay, tm.jitter, &rng_out));
+                pulse(UI_READ_ACK);
+                waited = 0;
+            } else if (sent_frames < frames && (status() & UO_IN_READY)) {
+                granted_ += asked;
+                asked = false;
+                if (pos < bytes.size()) {
+                    top_->uio_in = bytes[pos++];
+                    pulse(UI_BYTE_VALID);
+                    idle(vary(tm.byte_gap, tm.jitter, &rng_in));
+                } else {
+                    idle(tm.start_gap);
+                    pulse(close_bits());
+                    ++sent_frames;
+                    pos = 0;
+                }
+                waited = 0;
+            } else {
+                tick();
+                if (++waited > timeout_) return r;
+            }
+        }
+
+        r.cycles = cycle_ - t0;
+        r.ok = true;
+        return r;
+    }
+
+    // Push `frames` copies of one frame on each of `nctx` channels of an
+    // NCTX top. Every channel is a link of its own: a byte at most every
+    // byte_gap + 1 cycles, START start_gap cycles after its last byte. The
+    // host has one set of pins: each cycle it reads an output byte if
+    // BYTE_OUT_VALID is up, otherwise it serves the next channel, round
+    // robin, that is due and whose BYTE_IN_READY is up. bits holds channel
+    // 0's output bytes, then channel 1's, and so on; the run fails if a
+    // byte names a channel out of range or the channels' outputs differ in
+    // length. cycles covers the whole run.
+    FrameResult run_channels(const uint8_t *syms, int num_syms, int frames, int nctx,
+                             const Timing &tm = Timing()) {
+        FrameResult r;
+        const uint64_t t0 = cycle_;
+        const std::vector<uint8_t> bytes = pack_frame(syms, num_syms);
+        std::vector<std::vector<uint8_t>> out((size_t)nctx);
+        std::vector<size_t> pos((size_t)nctx, 0);
+        std::vector<int> sent((size_t)nctx, 0);
+        std::vector<uint64_t> due((size_t)nctx, cycle_);
+        int left = frames * nctx, next = 0;
+        uint64_t waited = 0;
+
+        while (left > 0 || !(status() & UO_DONE)) {
+            if (status() & UO_OUT_VALID) {
+                const unsigned ch = (unsigned)status() >> CHAN_SHIFT;
+                if (ch >= (unsigned)nctx) return r;
+                const uint8_t b = top_->uio_out;
+                for (int k = 0; k < 8; ++k) out[ch].push_back((b >> k) & 1u);
+                idle(tm.ack_delay);
+                pulse(UI_READ_ACK);
+                waited = 0;
+                continue;
+            }
+            // BYTE_IN_READY follows the channel on ui_in[7:5]
+            int c = -1;
+            for (int i = 0; i < nctx && c < 0; ++i) {
+                const int ch = (next + i) % nctx;
+                if (sent[ch] == frames || due[ch] > cycle_) continue;
+                top_->ui_in = chan_bits(ch);
+                top_->eval();
+                if (status() & UO_IN_READY) c = ch;
+            }
+            top_->ui_in = 0;
+            top_->eval();
+            if (c < 0) {
+                tick();
+                if (++waited > timeout_) return r;
+                continue;
+            }
+            next = (c + 1) % nctx;
+            if (pos[c] < bytes.size()) {
+                top_->uio_in = bytes[pos[c]++];
+                pulse((uint8_t)(UI_BYTE_VALID | chan_bits(c)));
+                due[c] = cycle_ + (pos[c] < bytes.size() ? tm.byte_gap : tm.start_gap);
+            } else {
+                pulse((uint8_t)(close_bits() | chan_bits(c)));
+                ++sent[c];
+                --left;
+                pos[c] = 0;
+                due[c] = cycle_ + tm.byte_gap;
+            }
+            waited = 0;
+        }
+
+        for (const auto &o : out) {
+            if (o.size() != out[0].size()) return r;
+            r.bits.insert(r.bits.end(), o.begin(), o.end());
+        }
+        r.cycles = cycle_ - t0;
+        r.ok = true;
+        return r;
+    }
+
+private:
+    static uint8_t chan_bits(int ch) { return (uint8_t)(ch << CHAN_SHIFT); }
+
+    // x +- j, uniform, never below 0 (xorshift32 state in *rng)
+    static unsigned vary(unsigned x, unsigned j, uint32_t *rng) {
+        if (!j) return x;
+        *rng ^= *rng << 13;
+        *rng ^= *rng >> 17;
+        *rng ^= *rng << 5;
+        const long v = (long)x - (long)j + (long)(*rng % (2 * j + 1));
+        return v < 0 ? 0u : (unsigned)v;
+    }
+
+    uint8_t close_bits() const {
+        return (uint8_t)(UI_START | (trunc_ ? UI_TRUNC : 0) | (tbite_ ? UI_TBITE : 0));
+    }
+
+    // Input bytes of a frame: the kept units (bits, or q-bit samples) of
+    // each symbol, c1 then c0, first unit in the LSBs. Without PUNCT that
+    // is 4 symbols or 1 soft symbol per byte. The last byte is zero-padded
+    std::vector<uint8_t> pack_frame(const uint8_t *syms, int num_syms) const {
+        const int w = soft_ ? soft_ : 1, upb = punct_units_per_byte(soft_);
+        const unsigned mask = (1u << w) - 1u;
+        std::vector<uint8_t> bytes;
+        int u = 0;
+        auto put = [&](unsigned v) {
+            if (u % upb == 0) bytes.push_back(0);
+            bytes.back() |= (uint8_t)((v & mask) << (w * (u % upb)));
+            ++u;
+        };
+        for (int t = 0; t < num_syms; ++t) {
+            const unsigned keep = punct_keep(punct_, t);
+            if (keep & 1u) put(syms[t]);
+            if (keep & 2u) put((unsigned)syms[t] >> w);
+        }
+        return bytes;
+    }
+
+    bool wait_for(uint8_t mask) {
+        for (uint64_t n = 0; !(status() & mask); ++n) {
+            if (n > timeout_) return false;
+            tick();
+        }
+        return true;
+    }
+
+    Top     *top_;
+    uint64_t timeout_;
+    uint64_t cycle_ = 0;
+    bool     last_byte_first_ = false;
+    bool     trunc_ = false;
+    bool     tbite_ = false;
+    int      soft_ = 0;
+    int      punct_ = 0;
+    bool     input_first_ = false;
+    uint64_t granted_ = 0;
+};
+
+}  // namespace topdrv
+
+#endif  // TOP_DRIVER_H
@@ -0,0 +1,159 @@
+/*
+ * viterbi_dpi.c
+ *
+ * Live C golden model for HDL testbenches, see viterbi_dpi.h.
+ * Build (one library per code):
+ *   gcc -shared -fPIC -DK=5 -DG0_OCT=023 -DG1_OCT=035 -I../c-tests \
+ *       viterbi_dpi.c -o viterbi_dpi_k5.so -lm
+ * or use Makefile.dpi, which also builds the Icarus VPI module.
+ */
+
+/* Pull in the model itself so the static helpers (hard_quantize_bpsk,
+ * soft_quantize_bpsk, gauss) are reachable; its main()s are all behind
+ * TEST_* guards. */
+#include "viterbi_golden.c"
+
+#include "viterbi_dpi.h"
+
+static uint8_t *bits_buf, *syms_buf, *dec_buf;
+static int      buf_cap;
+static int      soft_q;     /* vit_soft(): sample bits, 0 = hard symbols */
+
+static void ensure(int n) {
+    if (n <= buf_cap) return;
+    int cap = buf_cap ? buf_cap : 1024;
+    while (cap < n) cap *= 2;
+    bits_buf = (uint8_t *)realloc(bits_buf, cap);
+    syms_buf = (uint8_t *)realloc(syms_buf, cap);
+    dec_buf  = (uint8_t *)realloc(dec_buf, cap);
+    if (!bits_buf || !syms_buf || !dec_buf) { fprintf(stderr, "OOM vit_dpi\n"); exit(1); }
+    memset(bits_buf + buf_cap, 0, cap - buf_cap);
+    memset(syms_buf + buf_cap, 0, cap - buf_cap);
+    memset(dec_buf + buf_cap, 0, cap - buf_cap);
+    buf_cap = cap;
+}
+
+int  vit_k(void)                 { return K; }
+void vit_seed(unsigned int seed) { srand(seed); }
+
+void vit_set_bit(int i, int b)   { if (i >= 0) { ensure(i + 1); bits_buf[i] = (uint8_t)(b & 1); } }
+int  vit_get_bit(int i)          { return (i >= 0 && i < buf_cap) ? bits_buf[i] : 0; }
+void vit_set_sym(int t, int sym) { if (t >= 0) { ensure(t + 1); syms_buf[t] = (uint8_t)(sym & 3); } }
+int  vit_get_sym(int t)          { return (t >= 0 && t < buf_cap) ? syms_buf[t] : 0; }
+int  vit_get_dec(int i)          { return (i >= 0 && i < buf_cap) ? dec_buf[i] : 0; }
+void vit_soft(int q)             { soft_q = (q > 0 && q <= 4) ? q : 0; }
+
+void vit_rand_bits(int n) {
+    ensure(n);
+    for (int i = 0; i < n; ++i) bits_buf[i] = (uint8_t)(rand() & 1);
+}
+
+int vit_encode(int n) {
+    int T = 0;
+    ensure(n + K - 1);
+    conv_encode(bits_buf, n, syms_buf, &T);
+    return T;
+}
+
+int vit_decode(int T, int end_state) {
+    if (T < K - 1) return 0;
+    ensure(T);
+    return viterbi_decode_soft_from(syms_buf, T, dec_buf, end_state, soft_q);
+}
+
+int vit_decode_trunc(int T) {
+    if (T < 1) return 0;
+    ensure(T);
+    return viterbi_decode_soft_trunc(syms_buf, T, dec_buf, soft_q);
+}
+
+int vit_decode_window(int T, int depth, int trunc) {
+    if (T < (trunc ? 1 : K - 1)) return 0;
+    ensure(T);
+    return viterbi_decode_soft_window(syms_buf, T, dec_buf, depth, trunc, soft_q);
+}
+
+int vit_decode_streaming(int T, int D, int force_state0) {
+    ensure(T);
+    return viterbi_decode_streaming(syms_buf, T, D, dec_buf, force_state0);
+}
+
+int vit_decode_streaming_block(int T, int D, int B, int force_state0) {
+    if (B < 1) return 0;
+    ensure(T);
+    return viterbi_decode_streaming_block(syms_buf, T, D, B, dec_buf, force_state0);
+}
+
+static int count_flips(const uint8_t *before, int T) {
+    int n = 0;
+    for (int t = 0; t < T; ++t) {
+        uint8_t x = (before[t] ^ syms_buf[t]) & 3u;
+        n += (x & 1u) + (x >> 1);
+    }
+    return n;
+}
+
+int vit_bsc(int T, double p) {
+    ensure(T);
+    uint8_t *orig = (uint8_t *)malloc(T);
+    memcpy(orig, syms_buf, T);
+    bsc_hard(syms_buf, T, p);
+    int n = count_flips(orig, T);
+    free(orig);
+    return n;
+}
+
+int vit_gilbert_elliott(int T, double pg2b, double pb2g, double p_good, double p_bad) {
+    GE ch;
+    ensure(T);
+    uint8_t *orig = (uint8_t *)malloc(T);
+    memcpy(orig, syms_buf, T);
+    ge_init(&ch, pg2b, pb2g, p_good, p_bad);
+    gilbert_elliott(syms_buf, T, &ch);
+    int n = count_flips(orig, T);
+    free(orig);
+    return n;
+}
+
+/* BPSK over AWGN (rate 1/2) then hard decision, as in TEST_MAIN */
+int vit_awgn_hard(int T, double ebn0_db) {
+    ensure(T);
+    uint8_t *orig = (uint8_t *)malloc(T);
+    double  *y0   = (double *)malloc(sizeof(double) * T);
+    double  *y1   = (double *)malloc(sizeof(double) * T);
+    memcpy(orig, syms_buf, T);
+    awgn_bpsk(orig, T, ebn0_db, 0.5, y0, y1);
+    hard_quantize_bpsk(y0, y1, T, syms_buf);
+    int n = count_flips(orig, T);
+    free(orig); free(y0); free(y1);
+    return n;
+}
+
+int vit_isi_hard(int T, double alpha, double ebn0_db) {
+    ensure(T);
+    uint8_t *orig = (uint8_t *)malloc(T);
+    double  *y0   = (double *)malloc(sizeof(double) * T);
+    double  *y1   = (double *)malloc(sizeof(double) * T);
+    memcpy(orig, syms_buf, T);
+    two_tap_isi_bpsk(orig, T, alpha, ebn0_db, 0.5, y0, y1);
+    hard_quantize_bpsk(y0, y1, T, syms_buf);
+    int n = count_flips(orig, T);
+    free(orig); free(y0); free(y1);
+    return n;
+}
+
+int vit_awgn_soft(int T, double ebn0_db) {
+    if (!soft_q) return vit_awgn_hard(T, ebn0_db);
+    ensure(T);
+    double *y0 = (double *)malloc(sizeof(double) * T);
+    double *y1 = (double *)malloc(sizeof(double) * T);
+    awgn_bpsk(syms_buf, T, ebn0_db, 0.5, y0, y1);
+    int n = 0;
+    for (int t = 0; t < T; ++t) {
+        n += ((y0[t] < 0.0) != ((syms_buf[t] >> 1) & 1u));
+        n += ((y1[t] < 0.0) != (syms_buf[t] & 1u));
+    }
+    soft_quantize_bpsk(y0, y1, T, soft_q, syms_buf);
+    free(y0); free(y1);
+    return n;
+}
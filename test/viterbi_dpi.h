@@ -0,0 +1,72 @@
+/*
+ * viterbi_dpi.h
+ *
+ * C golden model (c-tests/viterbi_golden.c) exported to HDL testbenches.
+ * The same functions are imported through DPI-C by SystemVerilog simulators
+ * (viterbi_dpi_pkg.sv) and registered as $vit_* system functions for Icarus
+ * through VPI (viterbi_vpi.c).
+ *
+ * The library keeps three frame buffers that grow on demand:
+ *   bits[] - information bits           (vit_set_bit / vit_get_bit / vit_rand_bits)
+ *   syms[] - channel symbols            (vit_set_sym / vit_get_sym)
+ *   dec[]  - decoded bits               (vit_get_dec)
+ * so a bench can build a frame, encode it, corrupt it, decode it and compare
+ * against the DUT without any intermediate vector files.
+ *
+ * K, G0_OCT and G1_OCT are compile-time, one library per code.
+ *
+ * Symbols are 2-bit hard symbols until vit_soft(q) selects project.v's
+ * SOFT = q: syms[] then hold two q-bit samples each (sym_bm in
+ * viterbi_golden.c), as written by vit_awgn_soft, and every vit_decode*
+ * frame decode below uses the soft metric. The streaming decodes stay hard.
+ */
+
+#ifndef VITERBI_DPI_H
+#define VITERBI_DPI_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int  vit_k(void);
+void vit_seed(unsigned int seed);
+
+void vit_set_bit(int i, int b);
+int  vit_get_bit(int i);
+void vit_rand_bits(int n);
+void vit_set_sym(int t, int sym);
+int  vit_get_sym(int t);
+int  vit_get_dec(int i);
+/* q-bit soft symbols from here on, 0 = hard decision (the default) */
+void vit_soft(int q);
+
+/* conv_encode(): bits[0..n) -> syms[], returns T = n + K - 1 */
+int  vit_encode(int n);
+/* viterbi_decode_from(): syms[0..T) -> dec[], returns T - (K - 1).
+ * end_state < 0 traces back from the best end state. */
+int  vit_decode(int T, int end_state);
+/* viterbi_decode_trunc(): unterminated frame, best end state, returns T */
+int  vit_decode_trunc(int T);
+/* viterbi_decode_window(): project.v SURV_DEPTH = depth, returns the bit
+ * count of vit_decode (end state 0) or vit_decode_trunc (trunc != 0) */
+int  vit_decode_window(int T, int depth, int trunc);
+/* viterbi_decode_streaming(): syms[0..T) -> dec[], dec[t] is bit t-(D-1) */
+int  vit_decode_streaming(int T, int D, int force_state0);
+/* viterbi_decode_streaming_block(): viterbi_stream TB_BLOCK = B, same dec[]
+ * positions, returns the (T / B) * B outputs decided */
+int  vit_decode_streaming_block(int T, int D, int B, int force_state0);
+
+/* Channel models applied in place to syms[0..T), return flipped coded bits */
+int  vit_bsc(int T, double p);
+int  vit_gilbert_elliott(int T, double pg2b, double pb2g, double p_good, double p_bad);
+int  vit_awgn_hard(int T, double ebn0_db);
+int  vit_isi_hard(int T, double alpha, double ebn0_db);
+/* BPSK over AWGN, soft_quantize_bpsk to the vit_soft() width; returns the
+ * coded bits on the wrong side of the hard threshold */
+int  vit_awgn_soft(int T, double ebn0_db);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VITERBI_DPI_H */
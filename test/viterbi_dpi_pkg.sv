@@ -0,0 +1,34 @@
+// viterbi_dpi_pkg.sv
+// DPI-C imports of the live C golden model (viterbi_dpi.c / viterbi_dpi.h)
+// for SystemVerilog simulators (Verilator, commercial). Icarus has no DPI;
+// it gets the same functions as $vit_* system functions from viterbi_vpi.c.
+
+package viterbi_dpi_pkg;
+
+  import "DPI-C" function int  vit_k();
+  import "DPI-C" function void vit_seed(input int unsigned seed);
+
+  import "DPI-C" function void vit_set_bit(input int i, input int b);
+  import "DPI-C" function int  vit_get_bit(input int i);
+  import "DPI-C" function void vit_rand_bits(input int n);
+  import "DPI-C" function void vit_set_sym(input int t, input int sym);
+  import "DPI-C" function int  vit_get_sym(input int t);
+  import "DPI-C" function int  vit_get_dec(input int i);
+  import "DPI-C" function void vit_soft(input int q);
+
+  import "DPI-C" function int  vit_encode(input int n);
+  import "DPI-C" function int  vit_decode(input int T, input int end_state);
+  import "DPI-C" function int  vit_decode_trunc(input int T);
+  import "DPI-C" function int  vit_decode_window(input int T, input int depth, input int trunc);
+  import "DPI-C" function int  vit_decode_streaming(input int T, input int D, input int force_state0);
+  import "DPI-C" function int  vit_decode_streaming_block(input int T, input int D, input int B,
+                                                          input int force_state0);
+
+  import "DPI-C" function int  vit_bsc(input int T, input real p);
+  import "DPI-C" function int  vit_gilbert_elliott(input int T, input real pg2b, input real pb2g,
+                                                   input real p_good, input real p_bad);
+  import "DPI-C" function int  vit_awgn_hard(input int T, input real ebn0_db);
+  import "DPI-C" function int  vit_isi_hard(input int T, input real alpha, input real ebn0_db);
+  import "DPI-C" function int  vit_awgn_soft(input int T, input real ebn0_db);
+
+endpackage
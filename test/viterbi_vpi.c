@@ -0,0 +1,146 @@
+/*
+ * viterbi_vpi.c
+ *
+ * Icarus Verilog has no DPI-C, so the live golden model (viterbi_dpi.c) is
+ * registered as VPI system functions with the same names and arguments:
+ *
+ *   n = $vit_encode(nbits);          T = $vit_decode(T, end_state); ...
+ *
+ * Every $vit_* returns a 32-bit integer (void functions return 0).
+ * Build with iverilog-vpi, see Makefile.dpi:
+ *   iverilog-vpi -DK=5 -DG0_OCT=023 -DG1_OCT=035 -I../c-tests viterbi_vpi.c
+ *   vvp -M. -mviterbi_vpi sim.vvp
+ */
+
+#include <vpi_user.h>
+
+#include "viterbi_dpi.c"
+
+/* Argument signature per function: 'i' = integer, 'r' = real */
+typedef struct {
+    const char *name;
+    const char *args;
+} vit_func_t;
+
+enum {
+    F_K, F_SEED, F_SET_BIT, F_GET_BIT, F_RAND_BITS, F_SET_SYM, F_GET_SYM, F_GET_DEC,
+    F_SOFT, F_ENCODE, F_DECODE, F_DECODE_TRUNC, F_DECODE_WINDOW, F_DECODE_STREAMING,
+    F_DECODE_STREAMING_BLOCK, F_BSC, F_GE, F_AWGN, F_ISI, F_AWGN_SOFT, F_COUNT
+};
+
+static const vit_func_t vit_funcs[F_COUNT] = {
+    [F_K]                = { "$vit_k",                "" },
+    [F_SEED]             = { "$vit_seed",             "i" },
+    [F_SET_BIT]          = { "$vit_set_bit",          "ii" },
+    [F_GET_BIT]          = { "$vit_get_bit",          "i" },
+    [F_RAND_BITS]        = { "$vit_rand_bits",        "i" },
+    [F_SET_SYM]          = { "$vit_set_sym",          "ii" },
+    [F_GET_SYM]          = { "$vit_get_sym",          "i" },
+    [F_GET_DEC]          = { "$vit_get_dec",          "i" },
+    [F_SOFT]             = { "$vit_soft",             "i" },
+    [F_ENCODE]           = { "$vit_encode",           "i" },
+    [F_DECODE]           = { "$vit_decode",           "ii" },
+    [F_DECODE_TRUNC]     = { "$vit_decode_trunc",     "i" },
+    [F_DECODE_WINDOW]    = { "$vit_decode_window",    "iii" },
+    [F_DECODE_STREAMING] = { "$vit_decode_streaming", "iii" },
+    [F_DECODE_STREAMING_BLOCK] = { "$vit_decode_streaming_block", "iiii" },
+    [F_BSC]              = { "$vit_bsc",              "ir" },
+    [F_GE]               = { "$vit_gilbert_elliott",  "irrrr" },
+    [F_AWGN]             = { "$vit_awgn_hard",        "ir" },
+    [F_ISI]              = { "$vit_isi_hard",         "irr" },
+    [F_AWGN_SOFT]        = { "$vit_awgn_soft",        "ir" },
+};
+
+#define VIT_MAX_ARGS 5
+
+static PLI_INT32 vit_sizetf(PLI_BYTE8 *user_data) {
+    (void)user_data;
+    return 32;
+}
+
+static PLI_INT32 vit_compiletf(PLI_BYTE8 *user_data) {
+    const vit_func_t *f = &vit_funcs[(intptr_t)user_data];
+    vpiHandle self = vpi_handle(vpiSysTfCall, NULL);
+    vpiHandle it   = vpi_iterate(vpiArgument, self);
+    int n = 0;
+    if (it) {
+        while (vpi_scan(it)) ++n;
+    }
+    if (n != (int)strlen(f->args)) {
+        vpi_printf("ERROR: %s expects %d argument(s), got %d\n", f->name, (int)strlen(f->args), n);
+        vpi_control(vpiFinish, 1);
+    }
+    return 0;
+}
+
+static PLI_INT32 vit_calltf(PLI_BYTE8 *user_data) {
+    int id = (int)(intptr_t)user_data;
+    const vit_func_t *f = &vit_funcs[id];
+    int    iv[VIT_MAX_ARGS] = {0};
+    double rv[VIT_MAX_ARGS] = {0};
+    s_vpi_value v;
+
+    vpiHandle self = vpi_handle(vpiSysTfCall, NULL);
+    vpiHandle it   = vpi_iterate(vpiArgument, self);
+    for (int a = 0; it && f->args[a]; ++a) {
+        vpiHandle arg = vpi_scan(it);
+        if (!arg) break;
+        v.format = (f->args[a] == 'r') ? vpiRealVal : vpiIntVal;
+        vpi_get_value(arg, &v);
+        if (f->args[a] == 'r') rv[a] = v.value.real;
+        else                   iv[a] = v.value.integer;
+    }
+    if (it && f->args[0] && vpi_scan(it)) vpi_free_object(it);
+
+    int ret = 0;
+    switch (id) {
+    case F_K:                ret = vit_k(); break;
+    case F_SEED:             vit_seed((unsigned)iv[0]); break;
+    case F_SET_BIT:          vit_set_bit(iv[0], iv[1]); break;
+    case F_GET_BIT:          ret = vit_get_bit(iv[0]); break;
+    case F_RAND_BITS:        vit_rand_bits(iv[0]); break;
+    case F_SET_SYM:          vit_set_sym(iv[0], iv[1]); break;
+    case F_GET_SYM:          ret = vit_get_sym(iv[0]); break;
+    case F_GET_DEC:          ret = vit_get_dec(iv[0]); break;
+    case F_SOFT:             vit_soft(iv[0]); break;
+    case F_ENCODE:           ret = vit_encode(iv[0]); break;
+    case F_DECODE:           ret = vit_decode(iv[0], iv[1]); break;
+    case F_DECODE_TRUNC:     ret = vit_decode_trunc(iv[0]); break;
+    case F_DECODE_WINDOW:    ret = vit_decode_window(iv[0], iv[1], iv[2]); break;
+    case F_DECODE_STREAMING: ret = vit_decode_streaming(iv[0], iv[1], iv[2]); break;
+    case F_DECODE_STREAMING_BLOCK:
+        ret = vit_decode_streaming_block(iv[0], iv[1], iv[2], iv[3]);
+        break;
+    case F_BSC:              ret = vit_bsc(iv[0], rv[1]); break;
+    case F_GE:               ret = vit_gilbert_elliott(iv[0], rv[1], rv[2], rv[3], rv[4]); break;
+    case F_AWGN:             ret = vit_awgn_hard(iv[0], rv[1]); break;
+    case F_ISI:              ret = vit_isi_hard(iv[0], rv[1], rv[2]); break;
+    case F_AWGN_SOFT:        ret = vit_awgn_soft(iv[0], rv[1]); break;
+    default: break;
+    }
+
+    v.format = vpiIntVal;
+    v.value.integer = ret;
+    vpi_put_value(self, &v, NULL, vpiNoDelay);
+    return 0;
+}
+
+static void vit_register(void) {
+    for (intptr_t i = 0; i < F_COUNT; ++i) {
+        s_vpi_systf_data tf;
+        memset(&tf, 0, sizeof(tf));
+        tf.type        = vpiSysFunc;
+        tf.sysfunctype = vpiIntFunc;
+        tf.tfname      = (PLI_BYTE8 *)vit_funcs[i].name;
+        tf.calltf      = vit_calltf;
+        tf.compiletf   = vit_compiletf;
+        tf.sizetf      = vit_sizetf;
+        tf.user_data   = (PLI_BYTE8 *)i;
+        vpi_register_systf(&tf);
+    }
+}
+
+void (*vlog_startup_routines[])(void) = {
+    vit_register,
+    0
+};